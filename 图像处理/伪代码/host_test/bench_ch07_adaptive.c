@@ -0,0 +1,179 @@
+// 第7章 局部自适应阈值：逐点查询模式与全帧二值化模式的一致性与开销基准
+// 1. 同一帧上两种模式的起点、原始边缘点和方向必须完全相同；
+// 2. 分别统计局部阈值查询次数：逐点查询模式拆成起点搜索与轮廓跟踪两部分，全帧模式固定为 188*120 = 22560 次；
+// 3. 两种模式的每帧耗时 (都包含积分图构建)；
+// 4. image_main_process 在两种模式下提纯出的左右边界帧数。
+// 测试帧是 synth_curve 的 0/255 弯道，亮度从左侧 30% 线性过渡到右侧 100%，模拟半边阴影：
+// 左半边的白色赛道低于固定阈值 128，只有局部阈值能分出来。
+// 用法：bench_ch07_adaptive [帧数，默认300]
+#include <stdio.h>
+#include "../image_processing_07.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+static TrackContext lazy_ctx, full_ctx;
+
+static void gen_shadow(uint8_t *img, int seed)
+{
+    synth_curve(img, seed);
+    synth_black_border(img);
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (uint8_t)(img[y * SYNTH_W + x] * (30 + 70 * x / (SYNTH_W - 1)) / 100);
+        }
+    }
+}
+
+static void begin_trace(TrackContext *context, point left, point right)
+{
+    adjust_start_point_for_trace(&left, &right);
+    context->left_edge.start_point = left;
+    context->right_edge.start_point = right;
+    context->left_edge.grow_table = grow_l;
+    context->right_edge.grow_table = grow_r;
+}
+
+static bool same_trace(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->raw_points_count == b->raw_points_count &&
+           memcmp(a->raw_edge_points, b->raw_edge_points, (a->raw_points_count + 1) * sizeof(point)) == 0 &&
+           memcmp(a->raw_direction, b->raw_direction, a->raw_points_count + 1) == 0;
+}
+
+// 两种模式各走一遍起点搜索和轮廓跟踪，返回两者是否一致；found 输出是否找到起点
+static bool run_both(const uint8_t *image, bool *found, uint32_t *start_queries, uint32_t *trace_queries, uint32_t *full_queries)
+{
+    point l0, r0, l1, r1;
+
+    integral_image_build(image, &integral_image);
+    bool ok0 = get_start_point_adaptive(image, &integral_image, &l0, &r0);
+    *start_queries = integral_image.queries;
+    if (ok0)
+    {
+        begin_trace(&lazy_ctx, l0, r0);
+        search_line_adaptive(image, &integral_image, &lazy_ctx.left_edge, &lazy_ctx.right_edge, MAX_EDGE_POINTS * 2);
+    }
+    *trace_queries = integral_image.queries - *start_queries;
+
+    integral_image_build(image, &integral_image);
+    adaptive_binarize_and_pack(image, &integral_image, &binary_frame);
+    *full_queries = integral_image.queries;
+    bool ok1 = get_start_point_packed(&binary_frame, &l1, &r1);
+    if (ok1)
+    {
+        begin_trace(&full_ctx, l1, r1);
+        search_line_packed(&binary_frame, &full_ctx.left_edge, &full_ctx.right_edge, MAX_EDGE_POINTS * 2);
+    }
+
+    *found = ok0;
+    if (ok0 != ok1)
+    {
+        return false;
+    }
+    if (!ok0)
+    {
+        return true;
+    }
+    return memcmp(&l0, &l1, sizeof(point)) == 0 && memcmp(&r0, &r1, sizeof(point)) == 0 &&
+           same_trace(&lazy_ctx.left_edge, &full_ctx.left_edge) && same_trace(&lazy_ctx.right_edge, &full_ctx.right_edge);
+}
+
+// 返回左右都提纯成功的帧数
+static int count_main(AdaptiveMode mode, int frames)
+{
+    static TrackContext main_ctx;
+    int both = 0;
+
+    adaptive_mode = mode;
+    memset(&main_ctx, 0, sizeof(main_ctx));
+    main_ctx.left_edge.grow_table = grow_l;
+    main_ctx.right_edge.grow_table = grow_r;
+    for (int s = 0; s < frames; s++)
+    {
+        gen_shadow(mt9v03x_image_copy[0], s);
+        main_ctx.left_edge.is_found = main_ctx.right_edge.is_found = false;
+        image_main_process(&main_ctx);
+        both += main_ctx.left_edge.is_found && main_ctx.right_edge.is_found;
+    }
+    adaptive_mode = ADAPTIVE_MODE_LAZY;
+    return both;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 300;
+    int found = 0, differ = 0;
+    uint32_t start_min = UINT32_MAX, start_max = 0;
+    double start_sum = 0, trace_sum = 0, full_sum = 0, t_lazy = 0, t_full = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        bool ok;
+        uint32_t start_q, trace_q, full_q;
+        point l, r;
+
+        gen_shadow(mt9v03x_image_copy[0], s);
+        const uint8_t *image = mt9v03x_image_copy[0];
+        if (!run_both(image, &ok, &start_q, &trace_q, &full_q))
+        {
+            if (differ < 5)
+            {
+                printf("  seed %d: lazy and full-frame modes differ\n", s);
+            }
+            differ++;
+        }
+        found += ok;
+        start_sum += start_q;
+        trace_sum += trace_q;
+        full_sum += full_q;
+        start_min = start_q < start_min ? start_q : start_min;
+        start_max = start_q > start_max ? start_q : start_max;
+
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            integral_image_build(image, &integral_image);
+            if (get_start_point_adaptive(image, &integral_image, &l, &r))
+            {
+                begin_trace(&lazy_ctx, l, r);
+                search_line_adaptive(image, &integral_image, &lazy_ctx.left_edge, &lazy_ctx.right_edge, MAX_EDGE_POINTS * 2);
+            }
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            integral_image_build(image, &integral_image);
+            adaptive_binarize_and_pack(image, &integral_image, &binary_frame);
+            if (get_start_point_packed(&binary_frame, &l, &r))
+            {
+                begin_trace(&full_ctx, l, r);
+                search_line_packed(&binary_frame, &full_ctx.left_edge, &full_ctx.right_edge, MAX_EDGE_POINTS * 2);
+            }
+        }
+        double t2 = host_seconds();
+        t_lazy += t1 - t0;
+        t_full += t2 - t1;
+    }
+
+    double per_frame = 1e6 / ((double)frames * REPEAT);
+    printf("%d frames, start found %d, modes differ %d\n", frames, found, differ);
+    printf("queries per frame: lazy %.0f (start rows %.0f, min %u max %u; trace %.0f), full frame %.0f\n",
+           (start_sum + trace_sum) / frames, start_sum / frames, start_min, start_max, trace_sum / frames, full_sum / frames);
+    printf("time per frame incl. integral image: lazy %.2f us, full frame %.2f us\n", t_lazy * per_frame, t_full * per_frame);
+
+    int lazy_both = count_main(ADAPTIVE_MODE_LAZY, frames);
+    int full_both = count_main(ADAPTIVE_MODE_FULL_FRAME, frames);
+    printf("main process, both edges filtered: lazy %d, full frame %d of %d\n", lazy_both, full_both, frames);
+
+    if (differ || lazy_both != full_both)
+    {
+        printf("FAIL: the lazy adaptive mode differs from the full-frame mode\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// 第9章 ROI 走廊循迹的一致性与读取量基准
+// 在 synth_drift 的连续帧上运行两份主流程：一份正常使用上一帧的走廊，另一份每帧调用前把 roi.is_valid 清零，始终全图搜索。
+// 1. 两份的提纯结果 (左右 filtered_edge) 逐点比较，统计完全相同的帧数；
+// 2. 按本帧是否用上走廊分组，统计每帧读取的像素数 (RoiTracking.pixel_reads，起点搜索与循迹之和) 和走廊加宽次数。
+// 用法：bench_ch09_roi [帧数，默认400]
+#include <stdio.h>
+#include "../image_processing_09.c"
+#include "synth_frames.h"
+
+static TrackContext roi_ctx, full_ctx;
+
+static bool same_filtered(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->is_found == b->is_found && a->filtered_points_count == b->filtered_points_count &&
+           memcmp(a->filtered_edge, b->filtered_edge, a->filtered_points_count * sizeof(point)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 400;
+    int same = 0, both_found = 0, widened = 0;
+    long roi_reads = 0, full_reads = 0;
+
+    roi_ctx.left_edge.grow_table = full_ctx.left_edge.grow_table = grow_l;
+    roi_ctx.right_edge.grow_table = full_ctx.right_edge.grow_table = grow_r;
+    for (int t = 0; t < frames; t++)
+    {
+        synth_drift(mt9v03x_image_copy[0], t);
+
+        image_main_process(&roi_ctx);
+        full_ctx.roi.is_valid = false;
+        image_main_process(&full_ctx);
+
+        both_found += roi_ctx.left_edge.is_found && roi_ctx.right_edge.is_found;
+        same += same_filtered(&roi_ctx.left_edge, &full_ctx.left_edge) && same_filtered(&roi_ctx.right_edge, &full_ctx.right_edge);
+        widened += roi_ctx.roi.widen_count > 0;
+        if (roi_ctx.roi.used_roi)
+        {
+            roi_reads += roi_ctx.roi.pixel_reads;
+        }
+        full_reads += full_ctx.roi.pixel_reads;
+    }
+
+    uint32_t roi_frames = roi_ctx.roi.roi_frames;
+    printf("%d frames, both edges %d, filtered edges same as full search %d | corridor used %u, full search %u, widened %d\n",
+           frames, both_found, same, roi_frames, roi_ctx.roi.full_frames, widened);
+    printf("pixel reads per frame: corridor %.0f, full search %.0f\n",
+           roi_frames ? (double)roi_reads / roi_frames : 0.0, (double)full_reads / frames);
+
+    if (same * 100 < frames * 95 || roi_frames * 100 < (uint32_t)frames * 90)
+    {
+        printf("FAIL: the corridor is not used or its edges differ from the full search\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+// 第13章 邻域查表循迹的一致性与耗时基准
+// 对弯道、直道、直角弯三组合成帧，在同一张压缩二值图上从同一起点 (get_start_point_packed 后移到跟踪器出发点)
+// 分别运行逐像素探测的 search_line_packed 和查表的 search_line_lut：
+// 1. 左右两边的点数、原始边缘点和方向必须逐项相同；
+// 2. 两者每帧的循迹耗时和每秒跟踪的点数 (不含二值化)。
+// 用法：bench_ch13_lut [每组帧数，默认2000]
+#include <stdio.h>
+#include "../image_processing_13.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext probe, lut;
+
+static void gen_curve(uint8_t *img, int seed)
+{
+    synth_curve(img, seed);
+    synth_black_border(img); // 与其他两组一样四周为黑
+}
+
+static void begin_trace(TrackContext *context, point left, point right)
+{
+    context->left_edge.start_point = left;
+    context->right_edge.start_point = right;
+    context->left_edge.grow_table = grow_l;
+    context->right_edge.grow_table = grow_r;
+}
+
+static bool same_trace(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->raw_points_count == b->raw_points_count &&
+           memcmp(a->raw_edge_points, b->raw_edge_points, (a->raw_points_count + 1) * sizeof(point)) == 0 &&
+           memcmp(a->raw_direction, b->raw_direction, a->raw_points_count + 1) == 0;
+}
+
+// 返回不一致的帧数
+static int bench_set(const char *name, FrameGenerator gen, int frames)
+{
+    int used = 0, differ = 0;
+    long steps = 0;
+    double t_probe = 0, t_lut = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        point left, right;
+        gen(image, s);
+        binarize_and_pack(image, 128, &binary_frame);
+        if (!get_start_point_packed(&binary_frame, &left, &right))
+        {
+            continue;
+        }
+        adjust_start_point_for_trace(&left, &right);
+        begin_trace(&probe, left, right);
+        begin_trace(&lut, left, right);
+        used++;
+
+        search_line_packed(&binary_frame, &probe.left_edge, &probe.right_edge, MAX_EDGE_POINTS * 2);
+        search_line_lut(&binary_frame, &lut.left_edge, &lut.right_edge, MAX_EDGE_POINTS * 2);
+        if (!same_trace(&probe.left_edge, &lut.left_edge) || !same_trace(&probe.right_edge, &lut.right_edge))
+        {
+            if (differ < 5)
+            {
+                printf("  %s seed %d: left %d vs %d points, right %d vs %d points\n", name, s,
+                       probe.left_edge.raw_points_count, lut.left_edge.raw_points_count,
+                       probe.right_edge.raw_points_count, lut.right_edge.raw_points_count);
+            }
+            differ++;
+        }
+        steps += probe.left_edge.raw_points_count + probe.right_edge.raw_points_count;
+
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            search_line_packed(&binary_frame, &probe.left_edge, &probe.right_edge, MAX_EDGE_POINTS * 2);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            search_line_lut(&binary_frame, &lut.left_edge, &lut.right_edge, MAX_EDGE_POINTS * 2);
+        }
+        double t2 = host_seconds();
+        t_probe += t1 - t0;
+        t_lut += t2 - t1;
+    }
+
+    double per_frame = used ? 1e6 / ((double)used * REPEAT) : 0;
+    double msteps = (double)steps * REPEAT / 1e6;
+    printf("%-9s %5d frames, %.0f points per frame, differ %d | probe %.2f us (%.0f Msteps/s), lut %.2f us (%.0f Msteps/s)\n",
+           name, used, used ? (double)steps / used : 0.0, differ, t_probe * per_frame, t_probe > 0 ? msteps / t_probe : 0.0,
+           t_lut * per_frame, t_lut > 0 ? msteps / t_lut : 0.0);
+    return differ;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    int differ = 0;
+
+    neighbour_lut_init();
+    differ += bench_set("curve", gen_curve, frames);
+    differ += bench_set("vertical", synth_vertical, frames);
+    differ += bench_set("corner", synth_corner, frames);
+
+    if (differ)
+    {
+        printf("FAIL: search_line_lut differs from search_line_packed\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+// 第15章 游程引擎的一致性与耗时基准
+// 对每一帧分别运行轮廓跟踪 (search_line_packed + 行地图转换) 和游程引擎 (rle_encode_frame +
+// build_row_maps_from_runs)，在跟踪器写过点的行上比较两者的 mapped_edge，并统计两条路径的耗时。
+// 用法：bench_ch15_runs [每组帧数，默认2000]
+#include <stdio.h>
+#include "../image_processing_15.c"
+#include "host_pipeline.h"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext traced; // 轮廓跟踪结果
+static TrackContext runs;   // 游程引擎结果
+
+static bool prepare_frame(FrameGenerator gen, int seed, point *left, point *right)
+{
+    gen(image, seed);
+    binarize_and_pack(image, 128, &binary_frame);
+    if (!get_start_point_packed(&binary_frame, left, right))
+    {
+        return false;
+    }
+    runs.left_edge.start_point = *left;
+    runs.right_edge.start_point = *right;
+    return true;
+}
+
+// 返回 true 表示该组达到一致性下限
+static bool bench_set(const char *name, FrameGenerator gen, int frames)
+{
+    long used = 0, rows = 0, exact = 0, within1 = 0, end_diff = 0, total_runs = 0, dropped = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        point left, right;
+        if (!prepare_frame(gen, s, &left, &right))
+        {
+            continue;
+        }
+        host_trace_packed(&binary_frame, &traced, left, right);
+        rle_encode_frame(&binary_frame, &run_frame);
+        if (!build_row_maps_from_runs(&run_frame, &runs))
+        {
+            continue;
+        }
+        used++;
+        dropped += run_frame.dropped_runs;
+        for (int y = 0; y < IMAGE_H; y++)
+        {
+            total_runs += run_frame.count[y];
+        }
+
+        const EdgeTracker *a[2] = { &traced.left_edge, &traced.right_edge };
+        const EdgeTracker *b[2] = { &runs.left_edge, &runs.right_edge };
+        for (int e = 0; e < 2; e++)
+        {
+            int top = a[e]->mapped_edge_end_y > b[e]->mapped_edge_end_y ? a[e]->mapped_edge_end_y : b[e]->mapped_edge_end_y;
+            end_diff += abs(a[e]->mapped_edge_end_y - b[e]->mapped_edge_end_y);
+            for (int y = left.y; y >= top; y--)
+            {
+                if (!a[e]->mapped_edge[y])
+                {
+                    continue; // 跟踪器没有写到的行不参与比较
+                }
+                int d = abs(a[e]->mapped_edge[y] - b[e]->mapped_edge[y]);
+                rows++;
+                exact += d == 0;
+                within1 += d <= 1;
+            }
+        }
+    }
+
+    double trace_time = 0, run_time = 0;
+    for (int s = 0; s < frames; s++)
+    {
+        point left, right;
+        if (!prepare_frame(gen, s, &left, &right))
+        {
+            continue;
+        }
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            host_trace_packed(&binary_frame, &traced, left, right);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            rle_encode_frame(&binary_frame, &run_frame);
+            build_row_maps_from_runs(&run_frame, &runs);
+        }
+        double t2 = host_seconds();
+        trace_time += t1 - t0;
+        run_time += t2 - t1;
+    }
+
+    if (!used || !rows)
+    {
+        printf("%-12s no usable frames\n", name);
+        return false;
+    }
+    double exact_pct = 100.0 * exact / rows, within1_pct = 100.0 * within1 / rows;
+    printf("%-12s frames %ld  exact %.1f%%  <=1px %.1f%%  mean end-row diff %.1f  runs/frame %.1f  dropped %ld\n",
+           name, used, exact_pct, within1_pct, (double)end_diff / (2 * used), (double)total_runs / used, dropped);
+    printf("%-12s trace+map %.2f us/frame  rle+scan %.2f us/frame\n",
+           name, trace_time / (REPEAT * (double)frames) * 1e6, run_time / (REPEAT * (double)frames) * 1e6);
+    return within1_pct >= 98.0;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    bool ok = true;
+
+    ok &= bench_set("curve+noise", synth_curve, frames);
+    ok &= bench_set("vertical", synth_vertical, frames);
+    ok &= bench_set("corner", synth_corner, frames);
+
+    if (!ok)
+    {
+        printf("FAIL: run engine disagrees with the contour tracer\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
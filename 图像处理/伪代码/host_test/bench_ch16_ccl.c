@@ -0,0 +1,183 @@
+// 第16章 游程连通域标记的正确性、起点准确率与耗时基准
+// 1. 与逐像素 8 邻接泛洪填充比较“接触底部的最大连通域”的面积和外接矩形（标签未用尽的帧必须完全一致）；
+// 2. 底部放 0~2 个干扰白块，比较 get_start_point_packed 与 get_start_point_ccl 给出的起点是否落在真实赛道边上；
+// 3. 不同噪声强度下 rle_encode_frame 与标记的耗时。
+// 用法：bench_ch16_ccl [每组帧数，默认4000]
+#include <stdio.h>
+#include "../image_processing_16.c"
+#include "host_pipeline.h"
+#include "synth_frames.h"
+
+#define REPEAT 50 // 计时时每帧重复的次数
+
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static int true_left, true_right;
+
+static void make_frame(int seed, int blobs, int flips)
+{
+    synth_blob_track(image, seed, blobs, flips, &true_left, &true_right);
+    binarize_and_pack(image, 128, &binary_frame);
+    rle_encode_frame(&binary_frame, &run_frame);
+}
+
+// 逐像素 8 邻接泛洪填充，返回接触底部区域的最大连通域
+static int16_t flood_label[IMAGE_H][IMAGE_W];
+static uint8_t queue_x[IMAGE_H * IMAGE_W], queue_y[IMAGE_H * IMAGE_W];
+
+static bool flood_fill_reference(TrackComponent *out)
+{
+    int labels = 0, best_area = 0;
+    memset(flood_label, 0, sizeof(flood_label));
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            if (!BIN_PIXEL(&binary_frame, x, y) || flood_label[y][x])
+            {
+                continue;
+            }
+            int head = 0, tail = 0, area = 0;
+            int x0 = x, y0 = y, x1 = x, y1 = y;
+            bool bottom = false;
+            flood_label[y][x] = ++labels;
+            queue_x[tail] = x;
+            queue_y[tail++] = y;
+            while (head < tail)
+            {
+                int px = queue_x[head], py = queue_y[head++];
+                area++;
+                if (px < x0) x0 = px;
+                if (px > x1) x1 = px;
+                if (py < y0) y0 = py;
+                if (py > y1) y1 = py;
+                if (py >= CCL_BOTTOM_Y && py <= IMAGE_H - 2) bottom = true;
+                for (int dy = -1; dy <= 1; dy++)
+                {
+                    for (int dx = -1; dx <= 1; dx++)
+                    {
+                        int nx = px + dx, ny = py + dy;
+                        if (nx < 0 || ny < 0 || nx >= IMAGE_W || ny >= IMAGE_H) continue;
+                        if (BIN_PIXEL(&binary_frame, nx, ny) && !flood_label[ny][nx])
+                        {
+                            flood_label[ny][nx] = labels;
+                            queue_x[tail] = nx;
+                            queue_y[tail++] = ny;
+                        }
+                    }
+                }
+            }
+            if (bottom && area > best_area)
+            {
+                best_area = area;
+                out->area = area;
+                out->x_min = x0;
+                out->y_min = y0;
+                out->x_max = x1;
+                out->y_max = y1;
+            }
+        }
+    }
+    return best_area > 0;
+}
+
+// 起点落在第 116 行以下，且左右白边与真实赛道相差不超过2像素
+static bool seed_is_correct(point left, point right)
+{
+    return left.y >= IMAGE_H - 4 && abs(left.x + 2 - true_left) <= 2 && abs(right.x + 1 - true_right) <= 2;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 4000;
+    bool ok = true;
+
+    // --- 1. 与泛洪填充比较 ---
+    long compared = 0, mismatches = 0, overflow_frames = 0, overflow_differ = 0;
+    for (int s = 0; s < frames; s++)
+    {
+        make_frame(s, s % 3, (s % 4) * 300);
+        if (run_frame.dropped_runs)
+        {
+            continue;
+        }
+        TrackComponent reference = { 0 };
+        bool found = flood_fill_reference(&reference);
+        uint16_t label = ccl_label_runs(&run_frame, &track_component);
+        bool differ = found != (label != 0) ||
+                      (found && (reference.area != track_component.area ||
+                                 reference.x_min != track_component.x_min || reference.y_min != track_component.y_min ||
+                                 reference.x_max != track_component.x_max || reference.y_max != track_component.y_max));
+        compared++;
+        if (track_component.overflow_runs)
+        {
+            overflow_frames++;
+            overflow_differ += differ;
+        }
+        else
+        {
+            mismatches += differ;
+        }
+    }
+    printf("ccl vs flood fill: compared %ld  mismatches %ld  (label overflow in %ld frames, %ld of them differ)\n",
+           compared, mismatches, overflow_frames, overflow_differ);
+    ok &= mismatches == 0;
+
+    // --- 2. 起点准确率 ---
+    for (int blobs = 0; blobs <= 2; blobs++)
+    {
+        long packed_found = 0, packed_ok = 0, ccl_found = 0, ccl_ok = 0;
+        for (int s = 0; s < frames; s++)
+        {
+            point left, right;
+            make_frame(s + 100000, blobs, 100);
+            if (get_start_point_packed(&binary_frame, &left, &right))
+            {
+                packed_found++;
+                packed_ok += seed_is_correct(left, right);
+            }
+            if (get_start_point_ccl(&run_frame, &left, &right))
+            {
+                ccl_found++;
+                ccl_ok += seed_is_correct(left, right);
+            }
+        }
+        printf("blobs %d: packed found %ld correct %ld | ccl found %ld correct %ld (of %d)\n",
+               blobs, packed_found, packed_ok, ccl_found, ccl_ok, frames);
+        ok &= ccl_ok >= packed_ok;
+    }
+
+    // --- 3. 耗时 ---
+    for (int flips = 0; flips <= 600; flips += 300)
+    {
+        double t_packed = 0, t_encode = 0, t_label = 0;
+        long labels = 0;
+        for (int s = 0; s < 1000; s++)
+        {
+            point left, right;
+            make_frame(s, 1, flips);
+            double t0 = host_seconds();
+            for (int k = 0; k < REPEAT; k++) get_start_point_packed(&binary_frame, &left, &right);
+            double t1 = host_seconds();
+            for (int k = 0; k < REPEAT; k++) rle_encode_frame(&binary_frame, &run_frame);
+            double t2 = host_seconds();
+            for (int k = 0; k < REPEAT; k++) get_start_point_ccl(&run_frame, &left, &right);
+            double t3 = host_seconds();
+            t_packed += t1 - t0;
+            t_encode += t2 - t1;
+            t_label += t3 - t2;
+            labels += track_component.label_count;
+        }
+        printf("flips %d: get_start_point_packed %.2f us | rle_encode %.2f us + ccl %.2f us | labels/frame %.1f\n",
+               flips, t_packed / (REPEAT * 1000.0) * 1e6, t_encode / (REPEAT * 1000.0) * 1e6,
+               t_label / (REPEAT * 1000.0) * 1e6, labels / 1000.0);
+    }
+
+    if (!ok)
+    {
+        printf("FAIL: labelling disagrees with the flood fill or seeds worse than the pattern search\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+// 第17章 压缩二值图形态学去噪的正确性与效果基准
+// 1. 位运算的 3x3 腐蚀/膨胀、开、闭、先开后闭与逐像素参考实现逐位比较；
+// 2. 不同噪声强度下，比较不去噪与先开后闭两种情况提纯后的边缘长度（以同一帧无噪声时的长度为准）；
+// 3. 单次 3x3 与先开后闭的耗时。
+// 所有帧都是 synth_salt_track 合成的：弯道上随机翻转单个像素或水平相邻的两个像素，不是摄像头录制的帧。
+// 反光、行间条纹、成片的污渍等实际噪声不在其中，效果数字只说明对椒盐噪声的作用，上车前仍需用实拍图确认。
+// 用法：bench_ch17_morph [每组帧数，默认2000]
+#include <stdio.h>
+#include "../image_processing_17.c"
+#include "host_pipeline.h"
+#include "synth_frames.h"
+
+#define REPEAT 20000 // 计时循环次数
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext context;
+
+// 逐像素参考实现，图像外的像素按运算的单位元处理
+static uint8_t ref_a[IMAGE_H][IMAGE_W], ref_b[IMAGE_H][IMAGE_W];
+
+static void ref_3x3(bool erode)
+{
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            int v = erode;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    int nx = x + dx, ny = y + dy;
+                    if (nx < 0 || ny < 0 || nx >= IMAGE_W || ny >= IMAGE_H) continue;
+                    v = erode ? (v & ref_a[ny][nx]) : (v | ref_a[ny][nx]);
+                }
+            }
+            ref_b[y][x] = (uint8_t)v;
+        }
+    }
+    memcpy(ref_a, ref_b, sizeof(ref_a));
+}
+
+static void ref_denoise(MorphMode mode)
+{
+    if (mode == MORPH_OPEN || mode == MORPH_OPEN_CLOSE)
+    {
+        ref_3x3(true);
+        ref_3x3(false);
+    }
+    if (mode == MORPH_CLOSE || mode == MORPH_OPEN_CLOSE)
+    {
+        ref_3x3(false);
+        ref_3x3(true);
+    }
+}
+
+static bool frame_matches_reference(const BinaryFrame *frame)
+{
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        if (frame->row[y][BIN_ROW_WORDS - 1] & ~BIN_LAST_WORD_MASK)
+        {
+            return false; // 填充位必须保持为0
+        }
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            if (BIN_PIXEL(frame, x, y) != ref_a[y][x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 起点 + 跟踪 + 提纯，返回左右提纯后的点数之和，找不到起点返回 -1
+static int filtered_length(const BinaryFrame *frame, bool *breakpoint)
+{
+    point left, right;
+    if (!get_start_point_packed(frame, &left, &right))
+    {
+        return -1;
+    }
+    host_trace_packed(frame, &context, left, right);
+    extract_and_filter_edges_fused(&context);
+    *breakpoint = context.left_edge.breakpoint_flag || context.right_edge.breakpoint_flag;
+    return context.left_edge.filtered_points_count + context.right_edge.filtered_points_count;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    bool ok = true;
+
+    // --- 1. 与逐像素参考比较 ---
+    long cases = 0, mismatches = 0;
+    for (int s = 0; s < 300; s++)
+    {
+        synth_salt_track(image, s, 400 + s * 3);
+        binarize_and_pack(image, 128, &binary_frame);
+        for (int m = 0; m < 4; m++)
+        {
+            BinaryFrame f = binary_frame;
+            for (int y = 0; y < IMAGE_H; y++)
+            {
+                for (int x = 0; x < IMAGE_W; x++)
+                {
+                    ref_a[y][x] = BIN_PIXEL(&binary_frame, x, y);
+                }
+            }
+            if (m == 0)
+            {
+                morph_3x3(&f, s & 1); // 单次腐蚀或膨胀
+                ref_3x3(s & 1);
+            }
+            else
+            {
+                binary_frame_denoise(&f, (MorphMode)m);
+                ref_denoise((MorphMode)m);
+            }
+            cases++;
+            mismatches += !frame_matches_reference(&f);
+        }
+    }
+    printf("bitwise vs pixel reference: %ld cases, %ld mismatches\n", cases, mismatches);
+    ok &= mismatches == 0;
+
+    // --- 2. 去噪前后的边缘长度 ---
+    for (int flips = 300; flips <= 1200; flips *= 2)
+    {
+        long used = 0, raw_cut = 0, den_cut = 0, raw_brk = 0, den_brk = 0, raw_lost = 0, den_lost = 0;
+        double raw_kept = 0, den_kept = 0;
+        for (int s = 0; s < frames; s++)
+        {
+            bool brk;
+            synth_salt_track(image, s, 0);
+            binarize_and_pack(image, 128, &binary_frame);
+            int clean = filtered_length(&binary_frame, &brk);
+            if (clean <= 0)
+            {
+                continue;
+            }
+            used++;
+
+            synth_salt_track(image, s, flips);
+            binarize_and_pack(image, 128, &binary_frame);
+            BinaryFrame noisy = binary_frame;
+
+            int len = filtered_length(&binary_frame, &brk);
+            if (len < 0) raw_lost++;
+            else { raw_brk += brk; raw_cut += len < clean * 8 / 10; raw_kept += (double)len / clean; }
+
+            binary_frame = noisy;
+            binary_frame_denoise(&binary_frame, MORPH_OPEN_CLOSE);
+            len = filtered_length(&binary_frame, &brk);
+            if (len < 0) den_lost++;
+            else { den_brk += brk; den_cut += len < clean * 8 / 10; den_kept += (double)len / clean; }
+        }
+        printf("flips %4d frames %ld | raw: cut<80%% %5.1f%% kept %5.1f%% breakpoint %5.1f%% | "
+               "open+close: cut<80%% %5.1f%% kept %5.1f%% breakpoint %5.1f%%\n",
+               flips, used, 100.0 * raw_cut / used, 100.0 * raw_kept / (used - raw_lost), 100.0 * raw_brk / used,
+               100.0 * den_cut / used, 100.0 * den_kept / (used - den_lost), 100.0 * den_brk / used);
+        ok &= den_cut < raw_cut;
+    }
+
+    // --- 3. 耗时 ---
+    double t0 = host_seconds();
+    for (int k = 0; k < REPEAT; k++) morph_3x3(&binary_frame, k & 1);
+    double t1 = host_seconds();
+    for (int k = 0; k < REPEAT; k++) binary_frame_denoise(&binary_frame, MORPH_OPEN_CLOSE);
+    double t2 = host_seconds();
+    printf("3x3 pass %.2f us, open+close %.2f us per frame\n", (t1 - t0) / REPEAT * 1e6, (t2 - t1) / REPEAT * 1e6);
+
+    if (!ok)
+    {
+        printf("FAIL: bitwise morphology differs from the reference or does not reduce edge cuts\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
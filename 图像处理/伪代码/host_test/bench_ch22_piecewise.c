@@ -0,0 +1,106 @@
+// 第22章 分段贝塞尔与单段弦长参数化拟合的精度、耗时基准
+// 对弯道、S 弯、直角弯三组合成帧运行本章主流程，取每条提纯后的边缘分别用
+// fit_bezier_curve (第4章的单段弦长参数化拟合) 和 fit_bezier_piecewise 拟合，用同一个点到曲线距离 (牛顿迭代求最近点) 评估：
+// 1. 平均/最大误差、误差不超过 BEZIER_FIT_TOLERANCE 的边缘比例，分段拟合的平均段数和单段拟合次数；
+// 2. 每条边的拟合耗时 (分段拟合包含求误差的牛顿迭代，单段拟合不求误差)。
+// 分段后最大误差反而略大于单段的边只统计不算失败 (分割点固定后两段都超限、段数已用完时会出现)；
+// 误差在容差内的边数少于单段拟合时返回失败。
+// 用法：bench_ch22_piecewise [每组帧数，默认1000]
+#include <stdio.h>
+#include "../image_processing_22.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每条边重复的次数
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static TrackContext context;
+
+// 分段拟合在容差内的边数少于单段拟合时返回 false
+static bool run_set(const char *name, FrameGenerator gen, int frames)
+{
+    int edges = 0, worse = 0, single_ok = 0, pieces_ok = 0;
+    long segments = 0, fits = 0;
+    double single_sum = 0, pieces_sum = 0, single_max = 0, pieces_max = 0;
+    double t_single = 0, t_pieces = 0;
+    BezierPiecewise pieces;
+
+    memset(&context, 0, sizeof(context));
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    for (int s = 0; s < frames; s++)
+    {
+        gen(mt9v03x_image_copy[0], s);
+        context.left_edge.is_found = context.right_edge.is_found = false; // 找不到起点时主流程直接返回
+        image_main_process(&context);
+
+        EdgeTracker *trackers[2] = { &context.left_edge, &context.right_edge };
+        for (int e = 0; e < 2; e++)
+        {
+            const point *pts = trackers[e]->filtered_edge;
+            const int count = trackers[e]->filtered_points_count;
+            if (!trackers[e]->is_found || count < 4)
+            {
+                continue;
+            }
+
+            CubicBezier single = fit_bezier_curve(pts, count);
+            int worst_index;
+            double single_error = bezier_segment_error(&single, pts, count, &worst_index);
+            fit_bezier_piecewise(pts, count, BEZIER_FIT_TOLERANCE, &pieces);
+
+            edges++;
+            single_sum += single_error;
+            pieces_sum += pieces.max_error;
+            if (single_error > single_max) single_max = single_error;
+            if (pieces.max_error > pieces_max) pieces_max = pieces.max_error;
+            single_ok += single_error <= BEZIER_FIT_TOLERANCE;
+            pieces_ok += pieces.max_error <= BEZIER_FIT_TOLERANCE;
+            segments += pieces.segment_count;
+            fits += pieces.iterations;
+            if (pieces.max_error > single_error + 1e-4)
+            {
+                worse++;
+            }
+
+            double t0 = host_seconds();
+            for (int k = 0; k < REPEAT; k++)
+            {
+                single = fit_bezier_curve(pts, count);
+            }
+            double t1 = host_seconds();
+            for (int k = 0; k < REPEAT; k++)
+            {
+                fit_bezier_piecewise(pts, count, BEZIER_FIT_TOLERANCE, &pieces);
+            }
+            double t2 = host_seconds();
+            t_single += t1 - t0;
+            t_pieces += t2 - t1;
+        }
+    }
+
+    double n = edges ? edges : 1;
+    double per_edge = 1e6 / (n * REPEAT);
+    printf("%-9s %5d edges | single: mean %.2f max %5.2f px, within %.1f px %5.1f%%, %.2f us | "
+           "piecewise: mean %.2f max %.2f px, within %5.1f%%, %.2f segments, %.2f fits, %5.2f us, worse on %d\n",
+           name, edges, single_sum / n, single_max, BEZIER_FIT_TOLERANCE, 100.0 * single_ok / n, t_single * per_edge,
+           pieces_sum / n, pieces_max, 100.0 * pieces_ok / n, segments / n, fits / n, t_pieces * per_edge, worse);
+    return pieces_ok >= single_ok;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 1000;
+    bool ok = true;
+
+    ok &= run_set("curve", synth_curve, frames);
+    ok &= run_set("S curve", synth_s_curve, frames);
+    ok &= run_set("corner", synth_corner, frames);
+
+    if (!ok)
+    {
+        printf("FAIL: piecewise fit keeps fewer edges within tolerance than the single chord-length fit\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
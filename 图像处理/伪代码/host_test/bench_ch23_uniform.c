@@ -0,0 +1,157 @@
+// 第23章 均匀参数 (预计算权值表) 与弦长参数化贝塞尔拟合的精度、耗时基准
+// 1. 用 bezier_uniform_build_weights 按双精度重新生成 N = 8/16/32 的权值表，与源码中的 const 表逐项比较；
+// 2. 对弯道、S 弯、直角弯三组合成帧运行本章主流程，取每条提纯后的边缘分别用 fit_bezier_curve_uniform 和
+//    fit_bezier_curve (第4章，弦长参数化) 拟合，以点到曲线的最近距离 (在曲线上密集采样求最小值，与参数化方式无关) 评估
+//    平均距离和最大距离，并统计每条边的拟合耗时。
+// 权值表与生成结果不一致，或均匀参数的平均误差超过弦长参数化的 UNIFORM_ERROR_RATIO 倍时返回失败。
+// 用法：bench_ch23_uniform [每组帧数，默认1000]
+#include <stdio.h>
+#define BEZIER_UNIFORM_GENERATOR
+#include "../image_processing_23.c"
+#include "synth_frames.h"
+
+#define REPEAT              50   // 计时时每条边重复的次数
+#define CURVE_SAMPLES       400  // 求最近距离时在曲线上的采样数
+#define UNIFORM_ERROR_RATIO 2.0  // 均匀参数平均误差相对弦长参数化的上限
+#define TABLE_TOLERANCE     1e-6 // const 表与双精度生成结果的允许差
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static TrackContext context;
+
+// 返回 const 表与生成结果的最大差
+static double check_tables(void)
+{
+    double worst = 0, w1[32];
+    for (unsigned i = 0; i < BEZIER_UNIFORM_TABLE_COUNT; i++)
+    {
+        const BezierUniformTable *table = &bezier_uniform_tables[i];
+        bezier_uniform_build_weights(table->n, w1);
+        for (int k = 0; k < table->n; k++)
+        {
+            double d = fabs(w1[k] - table->w1[k]);
+            if (d > worst)
+            {
+                worst = d;
+            }
+        }
+    }
+    return worst;
+}
+
+// 每个点到曲线的最近距离，输出平均值和最大值
+static void curve_distance(const CubicBezier *c, const point *pts, int count, double *mean, double *max)
+{
+    static double cx[CURVE_SAMPLES + 1], cy[CURVE_SAMPLES + 1];
+    for (int i = 0; i <= CURVE_SAMPLES; i++)
+    {
+        double t = (double)i / CURVE_SAMPLES, u = 1.0 - t;
+        double b0 = u * u * u, b1 = 3 * t * u * u, b2 = 3 * t * t * u, b3 = t * t * t;
+        cx[i] = b0 * c->p0.x + b1 * c->p1.x + b2 * c->p2.x + b3 * c->p3.x;
+        cy[i] = b0 * c->p0.y + b1 * c->p1.y + b2 * c->p2.y + b3 * c->p3.y;
+    }
+
+    double sum = 0;
+    *max = 0;
+    for (int k = 0; k < count; k++)
+    {
+        double best = 1e30;
+        for (int i = 0; i <= CURVE_SAMPLES; i++)
+        {
+            double dx = cx[i] - pts[k].x, dy = cy[i] - pts[k].y;
+            double d2 = dx * dx + dy * dy;
+            if (d2 < best)
+            {
+                best = d2;
+            }
+        }
+        best = sqrt(best);
+        sum += best;
+        if (best > *max)
+        {
+            *max = best;
+        }
+    }
+    *mean = sum / count;
+}
+
+// 均匀参数的平均误差超过弦长参数化的 UNIFORM_ERROR_RATIO 倍时返回 false
+static bool run_set(const char *name, FrameGenerator gen, int frames)
+{
+    int edges = 0;
+    double chord_mean = 0, chord_max = 0, uniform_mean = 0, uniform_max = 0;
+    double t_chord = 0, t_uniform = 0;
+
+    memset(&context, 0, sizeof(context));
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    for (int s = 0; s < frames; s++)
+    {
+        gen(mt9v03x_image_copy[0], s);
+        context.left_edge.is_found = context.right_edge.is_found = false; // 找不到起点时主流程直接返回
+        image_main_process(&context);
+
+        EdgeTracker *trackers[2] = { &context.left_edge, &context.right_edge };
+        for (int e = 0; e < 2; e++)
+        {
+            const point *pts = trackers[e]->filtered_edge;
+            const int count = trackers[e]->filtered_points_count;
+            if (!trackers[e]->is_found || count < 4)
+            {
+                continue;
+            }
+
+            CubicBezier chord = fit_bezier_curve(pts, count);
+            CubicBezier uniform = fit_bezier_curve_uniform(pts, count);
+            double mean, max;
+            curve_distance(&chord, pts, count, &mean, &max);
+            chord_mean += mean;
+            if (max > chord_max) chord_max = max;
+            curve_distance(&uniform, pts, count, &mean, &max);
+            uniform_mean += mean;
+            if (max > uniform_max) uniform_max = max;
+            edges++;
+
+            double t0 = host_seconds();
+            for (int k = 0; k < REPEAT; k++)
+            {
+                chord = fit_bezier_curve(pts, count);
+            }
+            double t1 = host_seconds();
+            for (int k = 0; k < REPEAT; k++)
+            {
+                uniform = fit_bezier_curve_uniform(pts, count);
+            }
+            double t2 = host_seconds();
+            t_chord += t1 - t0;
+            t_uniform += t2 - t1;
+        }
+    }
+
+    double n = edges ? edges : 1;
+    double per_edge = 1e6 / (n * REPEAT);
+    printf("%-9s %5d edges | chord-length: mean %.2f max %5.2f px, %.2f us | uniform: mean %.2f max %5.2f px, %.2f us\n",
+           name, edges, chord_mean / n, chord_max, t_chord * per_edge, uniform_mean / n, uniform_max, t_uniform * per_edge);
+    return uniform_mean <= chord_mean * UNIFORM_ERROR_RATIO;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 1000;
+    bool ok = true;
+
+    double table_error = check_tables();
+    printf("weight tables vs bezier_uniform_build_weights: max difference %.2e\n", table_error);
+    ok &= table_error <= TABLE_TOLERANCE;
+
+    ok &= run_set("curve", synth_curve, frames);
+    ok &= run_set("S curve", synth_s_curve, frames);
+    ok &= run_set("corner", synth_corner, frames);
+
+    if (!ok)
+    {
+        printf("FAIL: uniform weight tables are stale or the uniform fit is far worse than the chord-length fit\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
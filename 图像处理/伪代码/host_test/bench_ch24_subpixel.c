@@ -0,0 +1,305 @@
+// 第24章 灰度亚像素边缘定位的真值精度、耗时基准
+// 赛道边界是已知的连续曲线 (中心随行号二次变化加线性偏移，宽度近大远小)，按像素面积采样生成灰度图
+// (背景 GREY_BLACK、赛道 GREY_WHITE，可加均匀噪声)，同一场景分别以 188x120 和 94x60 采样：
+// 1. 每行从赛道中心向两侧扫描得到紧邻边界的白点 (与跟踪得到的 filtered_edge 含义相同)，
+//    整数估计取白点外侧半个像素，亚像素估计用 refine_edge_subpixel；两种估计分别用 fit_bezier_curve_subpixel 拟合；
+// 2. 188x120 另外运行本章主流程，评估 left_subpixel / right_subpixel 和主流程拟合出的曲线；
+// 3. 误差统一换算成 188 像素单位：单点误差为估计值与该行真实边界 (行内面积平均) 之差，
+//    拟合误差为边缘点覆盖的各行真实边界点到拟合曲线的最近距离 (在曲线上密集采样求最小值)；
+// 4. refine_edge_subpixel 每点耗时。
+// 94x60 的帧放在 IMAGE_W 步长缓冲区的左上角 (右侧复制每行最后一个像素)，本章的跟踪和二值化按 188x120 编译，
+// 因此低分辨率只评估行扫描得到的边缘点。
+// 任一分辨率亚像素的单点平均误差不小于整数估计，或 94x60 亚像素拟合的平均误差超过 188x120 整数拟合时返回失败。
+// 用法：bench_ch24_subpixel [每组帧数，默认300]
+#include <stdio.h>
+#include "../image_processing_24.c"
+#include "synth_frames.h"
+
+#define REPEAT        50   // 计时时每条边重复的次数
+#define SUB_ROWS      8    // 面积采样时每个像素行内的子行数
+#define CURVE_SAMPLES 400  // 求最近距离时在曲线上的采样数
+#define GREY_BLACK    40   // 背景灰度
+#define GREY_WHITE    200  // 赛道灰度
+#define SCAN_THRESHOLD 120 // 行扫描时的白点阈值
+
+// 一帧场景：边界在 188 像素坐标系下为 y 的连续函数，像素中心为整数坐标
+typedef struct {
+    double cx, curv, slope, width;
+} Scene;
+
+typedef struct {
+    int    edges, points;
+    double point_sum, point_max; // 单点误差
+    double fit_sum, fit_max;     // 每条边的平均拟合误差之和、全部点的最大拟合误差
+    double seconds;
+} Score;
+
+static TrackContext context;
+static uint8_t lowres[IMAGE_H * IMAGE_W]; // 94x60 帧，步长与 188x120 相同
+
+static void scene_make(Scene *scene, int seed)
+{
+    srand(seed);
+    scene->cx = 84 + rand() % 2000 / 100.0;
+    scene->curv = ((rand() % 2000) - 1000) / 1000.0 * 45.0;
+    scene->slope = ((rand() % 2000) - 1000) / 1000.0 * 15.0;
+    scene->width = 110 + rand() % 2000 / 100.0;
+}
+
+// 188 坐标系下第 y 行 (可为小数) 的左右边界
+static void scene_edges(const Scene *scene, double y, double *left, double *right)
+{
+    const double t = 1.0 - y / (IMAGE_H - 1.0); // 近处为0，远处为1
+    const double c = scene->cx + scene->curv * t * t + scene->slope * t;
+    const double half = 0.5 * scene->width * (0.35 + 0.65 * (1.0 - t));
+    *left = c - half;
+    *right = c + half;
+}
+
+// 低分辨率第 row 行 (scale 为1或2) 的真实边界：行覆盖范围内子行边界的平均，坐标为 188 像素
+static void scene_row_truth(const Scene *scene, int scale, int row, double *left, double *right)
+{
+    double l_sum = 0, r_sum = 0;
+    for (int j = 0; j < SUB_ROWS * scale; j++)
+    {
+        double l, r;
+        scene_edges(scene, scale * row - 0.5 + (j + 0.5) / SUB_ROWS, &l, &r);
+        l_sum += l;
+        r_sum += r;
+    }
+    *left = l_sum / (SUB_ROWS * scale);
+    *right = r_sum / (SUB_ROWS * scale);
+}
+
+// 按面积采样生成 (IMAGE_W / scale) x (IMAGE_H / scale) 的灰度帧，写入步长为 IMAGE_W 的缓冲区
+static void scene_render(const Scene *scene, int scale, int noise, uint8_t *img)
+{
+    const int w = IMAGE_W / scale, h = IMAGE_H / scale;
+    static double cover[IMAGE_W];
+
+    for (int row = 0; row < h; row++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            cover[x] = 0;
+        }
+        for (int j = 0; j < SUB_ROWS * scale; j++)
+        {
+            double l, r;
+            scene_edges(scene, scale * row - 0.5 + (j + 0.5) / SUB_ROWS, &l, &r);
+            for (int x = 0; x < w; x++)
+            {
+                const double x0 = scale * x - 0.5, x1 = x0 + scale;
+                const double a = (l > x0) ? l : x0, b = (r < x1) ? r : x1;
+                cover[x] += (b > a) ? (b - a) / scale : 0;
+            }
+        }
+
+        uint8_t *line = img + row * IMAGE_W;
+        for (int x = 0; x < w; x++)
+        {
+            int g = (int)(GREY_BLACK + (GREY_WHITE - GREY_BLACK) * cover[x] / (SUB_ROWS * scale) + 0.5);
+            g += noise ? rand() % (2 * noise + 1) - noise : 0;
+            line[x] = (uint8_t)(g < 0 ? 0 : (g > 255 ? 255 : g));
+        }
+        for (int x = w; x < IMAGE_W; x++)
+        {
+            line[x] = line[w - 1];
+        }
+    }
+}
+
+// 每行从真实中心向两侧扫描，记录紧邻边界的白点，近处的行在前
+static void scan_edges(const Scene *scene, int scale, const uint8_t *img, EdgeTracker *left, EdgeTracker *right)
+{
+    const int w = IMAGE_W / scale, h = IMAGE_H / scale;
+    left->filtered_points_count = right->filtered_points_count = 0;
+    for (int row = h - 1; row >= 0; row--)
+    {
+        double l, r;
+        scene_row_truth(scene, scale, row, &l, &r);
+        const uint8_t *line = img + row * IMAGE_W;
+        int x = (int)((0.5 * (l + r) + 0.5) / scale);
+        if (line[x] <= SCAN_THRESHOLD)
+        {
+            continue;
+        }
+        int xl = x, xr = x;
+        while (xl > 1 && line[xl - 1] > SCAN_THRESHOLD) xl--;
+        while (xr < w - 2 && line[xr + 1] > SCAN_THRESHOLD) xr++;
+        left->filtered_edge[left->filtered_points_count++] = (point){(uint8_t)xl, (uint8_t)row};
+        right->filtered_edge[right->filtered_points_count++] = (point){(uint8_t)xr, (uint8_t)row};
+    }
+    left->is_found = right->is_found = true;
+}
+
+// 整数估计：边界在白点外侧半个像素 (与 refine_edge_subpixel 的退回值相同)
+static void integer_edges(const EdgeTracker *tracker, EdgePolarity polarity, SubpixelEdge *subpixel)
+{
+    for (int k = 0; k < tracker->filtered_points_count; k++)
+    {
+        subpixel->x[k] = (uint16_t)((tracker->filtered_edge[k].x << 8) + (polarity == EDGE_LEFT ? -128 : 128));
+    }
+    subpixel->is_valid = tracker->filtered_points_count > 0;
+}
+
+// 低分辨率坐标换算到 188 像素坐标
+static inline double to_full(double v, int scale)
+{
+    return scale * v + 0.5 * (scale - 1);
+}
+
+// 累计一条边的单点误差和拟合误差
+static void score_edge(Score *score, const Scene *scene, int scale, const EdgeTracker *tracker,
+                       const SubpixelEdge *subpixel, const CubicBezier *fit, EdgePolarity polarity)
+{
+    const int count = tracker->filtered_points_count;
+    if (count < 4)
+    {
+        return;
+    }
+
+    static double cx[CURVE_SAMPLES + 1], cy[CURVE_SAMPLES + 1];
+    for (int i = 0; i <= CURVE_SAMPLES; i++)
+    {
+        double t = (double)i / CURVE_SAMPLES, u = 1.0 - t;
+        double b0 = u * u * u, b1 = 3 * t * u * u, b2 = 3 * t * t * u, b3 = t * t * t;
+        cx[i] = to_full(b0 * fit->p0.x + b1 * fit->p1.x + b2 * fit->p2.x + b3 * fit->p3.x, scale);
+        cy[i] = to_full(b0 * fit->p0.y + b1 * fit->p1.y + b2 * fit->p2.y + b3 * fit->p3.y, scale);
+    }
+
+    int y_min = IMAGE_H, y_max = -1;
+    for (int k = 0; k < count; k++)
+    {
+        const int row = tracker->filtered_edge[k].y;
+        double l, r;
+        scene_row_truth(scene, scale, row, &l, &r);
+        const double truth = (polarity == EDGE_LEFT) ? l : r;
+        const double err = fabs(to_full(subpixel->x[k] / 256.0, scale) - truth);
+        score->point_sum += err;
+        score->point_max = (err > score->point_max) ? err : score->point_max;
+        score->points++;
+        y_min = (row < y_min) ? row : y_min;
+        y_max = (row > y_max) ? row : y_max;
+    }
+
+    // 拟合误差在 188 像素的每一行上评估，只取边缘点覆盖的行
+    double sum = 0;
+    int rows = 0;
+    for (int y = (int)ceil(to_full(y_min, scale)); y <= (int)floor(to_full(y_max, scale)); y++)
+    {
+        double l, r;
+        scene_row_truth(scene, 1, y, &l, &r);
+        const double tx = (polarity == EDGE_LEFT) ? l : r;
+        double best = 1e30;
+        for (int i = 0; i <= CURVE_SAMPLES; i++)
+        {
+            const double dx = cx[i] - tx, dy = cy[i] - y;
+            const double d2 = dx * dx + dy * dy;
+            best = (d2 < best) ? d2 : best;
+        }
+        best = sqrt(best);
+        sum += best;
+        score->fit_max = (best > score->fit_max) ? best : score->fit_max;
+        rows++;
+    }
+    score->fit_sum += rows ? sum / rows : 0;
+    score->edges++;
+}
+
+// 行扫描得到边缘点后，分别用整数估计和亚像素估计拟合并评分
+static void run_scan(const Scene *scene, int scale, const uint8_t *img, Score *integer, Score *refined)
+{
+    EdgeTracker *trackers[2] = { &context.left_edge, &context.right_edge };
+    SubpixelEdge *subpixels[2] = { &context.left_subpixel, &context.right_subpixel };
+    const EdgePolarity polarity[2] = { EDGE_LEFT, EDGE_RIGHT };
+
+    scan_edges(scene, scale, img, trackers[0], trackers[1]);
+    for (int e = 0; e < 2; e++)
+    {
+        integer_edges(trackers[e], polarity[e], subpixels[e]);
+        CubicBezier fit = fit_bezier_curve_subpixel(trackers[e], subpixels[e]);
+        score_edge(integer, scene, scale, trackers[e], subpixels[e], &fit, polarity[e]);
+
+        const double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            refine_edge_subpixel(img, trackers[e], polarity[e], subpixels[e]);
+        }
+        refined->seconds += host_seconds() - t0;
+        fit = fit_bezier_curve_subpixel(trackers[e], subpixels[e]);
+        score_edge(refined, scene, scale, trackers[e], subpixels[e], &fit, polarity[e]);
+    }
+}
+
+static void print_score(const char *set, const char *name, const Score *score)
+{
+    const double edges = score->edges ? score->edges : 1, points = score->points ? score->points : 1;
+    printf("%-9s %-14s %5d edges | point mean %.3f max %.2f px | fit mean %.3f max %.2f px",
+           set, name, score->edges, score->point_sum / points, score->point_max, score->fit_sum / edges, score->fit_max);
+    if (score->seconds > 0)
+    {
+        printf(" | refine %.1f ns per point", 1e9 * score->seconds / (points * REPEAT));
+    }
+    printf("\n");
+}
+
+// 亚像素没有改善单点误差，或 94x60 亚像素拟合比 188x120 整数拟合差时返回 false
+static bool run_set(const char *name, int noise, int frames)
+{
+    Score full_int = {0}, full_sub = {0}, half_int = {0}, half_sub = {0}, main_sub = {0};
+    Scene scene;
+
+    memset(&context, 0, sizeof(context));
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    for (int s = 0; s < frames; s++)
+    {
+        scene_make(&scene, s);
+
+        // 188x120：主流程 (跟踪得到的边缘点)
+        scene_render(&scene, 1, noise, mt9v03x_image_copy[0]);
+        synth_black_border(mt9v03x_image_copy[0]);
+        context.left_edge.is_found = context.right_edge.is_found = false; // 找不到起点时主流程直接返回
+        image_main_process(&context);
+        if (context.left_bezier_found)
+        {
+            score_edge(&main_sub, &scene, 1, &context.left_edge, &context.left_subpixel, &context.left_bezier, EDGE_LEFT);
+        }
+        if (context.right_bezier_found)
+        {
+            score_edge(&main_sub, &scene, 1, &context.right_edge, &context.right_subpixel, &context.right_bezier, EDGE_RIGHT);
+        }
+
+        // 同一场景的行扫描，188x120 与 94x60
+        run_scan(&scene, 1, mt9v03x_image_copy[0], &full_int, &full_sub);
+        scene_render(&scene, 2, noise, lowres);
+        run_scan(&scene, 2, lowres, &half_int, &half_sub);
+    }
+
+    print_score(name, "188x120 main", &main_sub);
+    print_score(name, "188x120 int", &full_int);
+    print_score(name, "188x120 sub", &full_sub);
+    print_score(name, "94x60 int", &half_int);
+    print_score(name, "94x60 sub", &half_sub);
+
+    return full_sub.point_sum / full_sub.points < full_int.point_sum / full_int.points &&
+           half_sub.point_sum / half_sub.points < half_int.point_sum / half_int.points &&
+           half_sub.fit_sum / half_sub.edges <= full_int.fit_sum / full_int.edges;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 300;
+    bool ok = true;
+
+    ok &= run_set("clean", 0, frames);
+    ok &= run_set("noise 4", 4, frames);
+
+    if (!ok)
+    {
+        printf("FAIL: sub-pixel refinement does not beat the integer edges, or 94x60 sub-pixel fits worse than 188x120 integer\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+// 第25章 金字塔循迹的一致性与耗时基准
+// 1. 四类合成帧上，金字塔路径与全分辨率路径 (search_line_packed) 的行地图逐行比较：覆盖率、完全一致、相差不超过1像素的比例，
+//    以及退回全分辨率的帧数；
+// 2. 0.5% 噪点帧上，两条路径的提纯结果都与同一帧无噪声时的全分辨率结果比较；
+// 3. image_main_process 在 pyramid_enabled 为 false 时走退回路径，每帧都必须得到提纯后的边界；
+// 4. 二值化与循迹两个阶段各自的耗时。
+// 用法：bench_ch25_pyramid [每类帧数，默认300]
+#include <stdio.h>
+#include "../image_processing_25.c"
+#include "host_pipeline.h"
+#include "synth_frames.h"
+
+#define REPEAT       100 // 计时时每帧重复的次数
+#define SPECK_FLIPS  113 // 约占整帧 0.5% 的翻转像素
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext full_ctx, pyr_ctx, clean_ctx;
+
+static void gen_curve(uint8_t *img, int seed)    { synth_salt_track(img, seed, 0); }
+static void gen_specks(uint8_t *img, int seed)   { synth_salt_track(img, seed, SPECK_FLIPS); }
+
+// 全分辨率参考路径，找不到起点返回 false
+static bool full_path(TrackContext *context)
+{
+    point left, right;
+    memset(context, 0, sizeof(*context));
+    binarize_and_pack(image, 128, &binary_frame);
+    if (!get_start_point_packed(&binary_frame, &left, &right))
+    {
+        return false;
+    }
+    host_trace_packed(&binary_frame, context, left, right);
+    extract_and_filter_edges_fused(context);
+    return true;
+}
+
+// 金字塔路径，失败时与 image_main_process 一样退回全分辨率
+static bool pyramid_path(TrackContext *context, bool *fell_back)
+{
+    memset(context, 0, sizeof(*context));
+    binarize_and_pack_pyramid(image, 128, &binary_frame, &coarse_frame);
+    *fell_back = !trace_pyramid(&binary_frame, &coarse_frame, context);
+    if (*fell_back)
+    {
+        return full_path(context);
+    }
+    extract_and_filter_edges_fused(context);
+    return true;
+}
+
+static inline bool row_mapped(const EdgeTracker *e, int y)
+{
+    return e->mapped_edge[y] != 0 && y <= e->mapped_edge_start_y && y >= e->mapped_edge_end_y;
+}
+
+typedef struct {
+    long full_rows, covered, compared, exact, near;
+} MapAgreement;
+
+static void compare_maps(MapAgreement *m)
+{
+    for (int s = 0; s < 2; s++)
+    {
+        const EdgeTracker *a = s ? &full_ctx.right_edge : &full_ctx.left_edge;
+        const EdgeTracker *b = s ? &pyr_ctx.right_edge : &pyr_ctx.left_edge;
+        for (int y = 0; y < IMAGE_H; y++)
+        {
+            if (row_mapped(a, y))
+            {
+                m->full_rows++;
+                m->covered += row_mapped(b, y);
+            }
+            if (row_mapped(a, y) && row_mapped(b, y))
+            {
+                int d = abs(a->mapped_edge[y] - b->mapped_edge[y]);
+                m->compared++;
+                m->exact += d == 0;
+                m->near += d <= 1;
+            }
+        }
+    }
+}
+
+// 提纯结果中与 clean_ctx 同一行且相差不超过1像素的点数
+static long filtered_within_one(const TrackContext *t, long *total)
+{
+    long hits = 0;
+    for (int s = 0; s < 2; s++)
+    {
+        const EdgeTracker *a = s ? &clean_ctx.right_edge : &clean_ctx.left_edge;
+        const EdgeTracker *b = s ? &t->right_edge : &t->left_edge;
+        for (int i = 0; i < a->filtered_points_count; i++)
+        {
+            (*total)++;
+            for (int j = 0; j < b->filtered_points_count; j++)
+            {
+                if (b->filtered_edge[j].y == a->filtered_edge[i].y)
+                {
+                    hits += abs(b->filtered_edge[j].x - a->filtered_edge[i].x) <= 1;
+                    break;
+                }
+            }
+        }
+    }
+    return hits;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 300;
+    bool ok = true;
+
+    // --- 1. 行地图一致性与耗时 ---
+    static const struct { const char *name; FrameGenerator gen; } kinds[] = {
+        { "curve",          gen_curve },
+        { "crossing",       synth_crossing },
+        { "90-degree turn", synth_corner },
+        { "specks 0.5%",    gen_specks },
+    };
+    for (unsigned k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++)
+    {
+        MapAgreement m = { 0 };
+        int used = 0, fallbacks = 0;
+        double t_bin = 0, t_bin_pyr = 0, t_full = 0, t_pyr = 0;
+
+        for (int s = 0; s < frames; s++)
+        {
+            bool fell_back;
+            kinds[k].gen(image, s);
+            if (!full_path(&full_ctx) || !pyramid_path(&pyr_ctx, &fell_back))
+            {
+                continue;
+            }
+            used++;
+            fallbacks += fell_back;
+            compare_maps(&m);
+
+            point left, right;
+            double t0 = host_seconds();
+            for (int r = 0; r < REPEAT; r++) binarize_and_pack(image, 128, &binary_frame);
+            double t1 = host_seconds();
+            for (int r = 0; r < REPEAT; r++)
+            {
+                get_start_point_packed(&binary_frame, &left, &right);
+                host_trace_packed(&binary_frame, &full_ctx, left, right);
+            }
+            double t2 = host_seconds();
+            for (int r = 0; r < REPEAT; r++) binarize_and_pack_pyramid(image, 128, &binary_frame, &coarse_frame);
+            double t3 = host_seconds();
+            for (int r = 0; r < REPEAT; r++) trace_pyramid(&binary_frame, &coarse_frame, &pyr_ctx);
+            double t4 = host_seconds();
+            t_bin += t1 - t0;
+            t_full += t2 - t1;
+            t_bin_pyr += t3 - t2;
+            t_pyr += t4 - t3;
+        }
+        double per_frame = 1e6 / ((double)used * REPEAT);
+        printf("%-15s %4d frames fallback %3d | coverage %5.1f%% exact %5.1f%% within1 %5.1f%% | "
+               "binarize %.2f -> %.2f us, trace %.2f -> %.2f us\n",
+               kinds[k].name, used, fallbacks, 100.0 * m.covered / m.full_rows, 100.0 * m.exact / m.compared,
+               100.0 * m.near / m.compared, t_bin * per_frame, t_bin_pyr * per_frame, t_full * per_frame, t_pyr * per_frame);
+        if (kinds[k].gen != gen_specks)
+        {
+            ok &= m.near * 100 >= m.compared * 98; // 无噪声时两条路径应基本一致
+        }
+    }
+
+    // --- 2. 噪点帧与无噪声结果比较 ---
+    long total_full = 0, total_pyr = 0, hit_full = 0, hit_pyr = 0;
+    for (int s = 0; s < frames; s++)
+    {
+        bool fell_back;
+        synth_salt_track(image, s, 0);
+        if (!full_path(&clean_ctx))
+        {
+            continue;
+        }
+        gen_specks(image, s);
+        if (full_path(&full_ctx))
+        {
+            hit_full += filtered_within_one(&full_ctx, &total_full);
+        }
+        if (pyramid_path(&pyr_ctx, &fell_back))
+        {
+            hit_pyr += filtered_within_one(&pyr_ctx, &total_pyr);
+        }
+    }
+    printf("specks vs clean filtered edge: full %.1f%% within1, pyramid %.1f%% within1\n",
+           100.0 * hit_full / total_full, 100.0 * hit_pyr / total_pyr);
+
+    // --- 3. 主流程的退回路径 ---
+    // 退回路径与 host_trace_packed 一样移位起点，左右边界都与参考路径逐行比较
+    int main_frames = 0, main_found = 0;
+    long main_rows = 0, main_near = 0;
+    pyramid_enabled = false;
+    for (int s = 0; s < frames; s++)
+    {
+        static TrackContext main_ctx;
+        synth_salt_track(image, s, 0);
+        if (!full_path(&clean_ctx) || clean_ctx.left_edge.filtered_points_count == 0 ||
+            clean_ctx.right_edge.filtered_points_count == 0)
+        {
+            continue;
+        }
+        memcpy(mt9v03x_image_copy, image, sizeof(image));
+        memset(&main_ctx, 0, sizeof(main_ctx));
+        main_ctx.left_edge.grow_table = grow_l;
+        main_ctx.right_edge.grow_table = grow_r;
+        image_main_process(&main_ctx);
+        main_frames++;
+        main_found += main_ctx.left_edge.filtered_points_count > 0 && main_ctx.right_edge.filtered_points_count > 0;
+        main_near += filtered_within_one(&main_ctx, &main_rows);
+    }
+    pyramid_enabled = true;
+    printf("main with pyramid off: %d frames, both edges filtered in %d, %.1f%% of reference rows within1\n",
+           main_frames, main_found, 100.0 * main_near / main_rows);
+    ok &= main_found == main_frames && main_near * 100 >= main_rows * 95;
+
+    if (!ok)
+    {
+        printf("FAIL: pyramid maps disagree with the full tracer or the fallback path loses the edges\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
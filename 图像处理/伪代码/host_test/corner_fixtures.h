@@ -0,0 +1,166 @@
+#ifndef __CORNER_FIXTURES_H__
+#define __CORNER_FIXTURES_H__
+
+// 第20章 链码拐角检测的合成轮廓：每个函数按种子画一帧 0/255 二值图，并给出左右边界应当检测到的拐角列表（按跟踪顺序）。
+// 必须在 image_processing_20.c 之后包含，拐角类型来自 ChainCornerType。
+#include <math.h>
+#include <string.h>
+#include "synth_frames.h"
+
+#define FIXTURE_MAX_CORNERS 4
+
+typedef struct {
+    uint8_t type; // ChainCornerType
+    int16_t x;
+    int16_t y;
+} ExpectedCorner;
+
+typedef struct {
+    const char     *name;
+    ExpectedCorner  left[FIXTURE_MAX_CORNERS];
+    uint8_t         left_count;
+    ExpectedCorner  right[FIXTURE_MAX_CORNERS];
+    uint8_t         right_count;
+    uint8_t         min_reached; // 左右两边合计至少要走到的期望拐角数，跟踪器提前停下时不会让比较空过
+    uint16_t        min_points;  // 较短的一条边至少要有的链码点数 (raw_points_count)
+} CornerFixture;
+
+static inline void fixture_rect(uint8_t *img, int x0, int y0, int x1, int y1)
+{
+    for (int y = y0; y <= y1; y++)
+    {
+        for (int x = x0; x <= x1; x++)
+        {
+            if (x >= 0 && x < SYNTH_W && y >= 0 && y < SYNTH_H)
+            {
+                img[y * SYNTH_W + x] = 255;
+            }
+        }
+    }
+}
+
+static inline void fixture_expect(ExpectedCorner *list, uint8_t *count, ChainCornerType type, int x, int y)
+{
+    list[*count].type = (uint8_t)type;
+    list[*count].x = (int16_t)x;
+    list[*count].y = (int16_t)y;
+    (*count)++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      各种斜率的直道：不应报告任何拐角
+//-------------------------------------------------------------------------------------------------------------------
+static inline void fixture_straight(uint8_t *img, int seed, CornerFixture *fx)
+{
+    memset(img, 0, SYNTH_W * SYNTH_H);
+    memset(fx, 0, sizeof(*fx));
+    fx->name = "straight";
+    fx->min_reached = 0;
+    fx->min_points = 110;
+    srand(seed);
+    int cx = 70 + rand() % 50, w = 60 + rand() % 40;
+    double slope = (rand() % 1000 - 500) / 600.0;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        int c = (int)(cx + slope * (SYNTH_H - 1 - y) * 0.5);
+        fixture_rect(img, c - w / 2, y, c + w / 2, y);
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      半径 130~300 像素的缓弯：不应报告任何拐角
+//-------------------------------------------------------------------------------------------------------------------
+static inline void fixture_arc(uint8_t *img, int seed, CornerFixture *fx)
+{
+    memset(img, 0, SYNTH_W * SYNTH_H);
+    memset(fx, 0, sizeof(*fx));
+    fx->name = "arc";
+    fx->min_reached = 0;
+    fx->min_points = 110;
+    srand(seed);
+    int cx = 60 + rand() % 60, w = 50 + rand() % 30;
+    double radius = 130 + rand() % 170;
+    int dir = (rand() & 1) ? 1 : -1;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        double off = radius - sqrt(fmax(radius * radius - dy * dy, 0));
+        int c = (int)(cx + dir * off);
+        fixture_rect(img, c - w / 2, y, c + w / 2, y);
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      十字路口：竖直赛道加一条贯穿全宽的横带
+// 备注信息      两条边界各在横带下沿和上沿出现一个向外的拐角。沿横带绕行后链码点数可能用完，
+//               最后一个拐角不一定走到，所以只要求走到 3 个。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void fixture_crossing(uint8_t *img, int seed, CornerFixture *fx)
+{
+    memset(img, 0, SYNTH_W * SYNTH_H);
+    memset(fx, 0, sizeof(*fx));
+    fx->name = "crossing";
+    fx->min_reached = 3;
+    fx->min_points = 200;
+    srand(seed);
+    int cx = 80 + rand() % 30, w = 50 + rand() % 20, band_y = 35 + rand() % 20, band_h = 15 + rand() % 10;
+    fixture_rect(img, cx - w / 2, 0, cx + w / 2, SYNTH_H - 1);
+    fixture_rect(img, 1, band_y, SYNTH_W - 2, band_y + band_h);
+    synth_black_border(img);
+
+    fixture_expect(fx->left, &fx->left_count, CORNER_OUTWARD, cx - w / 2, band_y + band_h);
+    fixture_expect(fx->left, &fx->left_count, CORNER_OUTWARD, cx - w / 2, band_y);
+    fixture_expect(fx->right, &fx->right_count, CORNER_OUTWARD, cx + w / 2, band_y + band_h);
+    fixture_expect(fx->right, &fx->right_count, CORNER_OUTWARD, cx + w / 2, band_y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      直角右转：赛道向上后向右拐
+// 备注信息      右边界 (弯内侧) 在拐弯处有一个向外的拐角，左边界 (弯外侧) 在横段上沿有一个向内的拐角。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void fixture_right_turn(uint8_t *img, int seed, CornerFixture *fx)
+{
+    memset(img, 0, SYNTH_W * SYNTH_H);
+    memset(fx, 0, sizeof(*fx));
+    fx->name = "90-degree turn";
+    fx->min_reached = 2;
+    fx->min_points = 150;
+    srand(seed);
+    int cx = 60 + rand() % 20, w = 40 + rand() % 10, top = 50 + rand() % 15;
+    fixture_rect(img, cx - w / 2, top, cx + w / 2, SYNTH_H - 1);
+    fixture_rect(img, cx - w / 2, top - w + 10, SYNTH_W - 2, top + 9);
+    synth_black_border(img);
+
+    fixture_expect(fx->left, &fx->left_count, CORNER_INWARD, cx - w / 2, top - w + 10);
+    fixture_expect(fx->right, &fx->right_count, CORNER_OUTWARD, cx + w / 2, top + 10);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      S 形错位：上半段赛道整体右移 shift 个像素
+// 备注信息      左边界依次为向内拐角、拐点、向外拐角，右边界依次为向外拐角、拐点、向内拐角，拐点在两拐角中间。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void fixture_s_jog(uint8_t *img, int seed, CornerFixture *fx)
+{
+    memset(img, 0, SYNTH_W * SYNTH_H);
+    memset(fx, 0, sizeof(*fx));
+    fx->name = "S jog";
+    fx->min_reached = 6;
+    fx->min_points = 120;
+    srand(seed);
+    int cx = 60 + rand() % 20, w = 50 + rand() % 10, jog_y = 50 + rand() % 20, shift = 20 + rand() % 15;
+    int left = cx - w / 2, right = cx + w / 2;
+    fixture_rect(img, left, jog_y, right, SYNTH_H - 1);
+    fixture_rect(img, left + shift, 0, right + shift, jog_y - 1);
+    synth_black_border(img);
+
+    fixture_expect(fx->left, &fx->left_count, CORNER_INWARD, left, jog_y);
+    fixture_expect(fx->left, &fx->left_count, CORNER_INFLECTION, left + shift / 2, jog_y);
+    fixture_expect(fx->left, &fx->left_count, CORNER_OUTWARD, left + shift, jog_y);
+    fixture_expect(fx->right, &fx->right_count, CORNER_OUTWARD, right, jog_y);
+    fixture_expect(fx->right, &fx->right_count, CORNER_INFLECTION, right + shift / 2, jog_y);
+    fixture_expect(fx->right, &fx->right_count, CORNER_INWARD, right + shift, jog_y);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+// 主机端模拟的 CMSIS 内联指令，只实现 image_kernels.c 用到的几条，用于在电脑上验证 DSP 路径的结果。
+// 按 ARMv7E-M 架构手册的定义逐字节计算；APSR.GE[3:0] 用一个静态变量代替，__USUB8 写入、__SEL 读取。
+#include <stdint.h>
+
+static uint32_t host_apsr_ge;
+
+// 按字节无符号减法，第 i 个字节不借位 (op1 >= op2) 时置位 GE[i]
+static inline uint32_t __USUB8(uint32_t op1, uint32_t op2)
+{
+    uint32_t result = 0;
+    host_apsr_ge = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        int diff = (int)((op1 >> (8 * i)) & 0xFF) - (int)((op2 >> (8 * i)) & 0xFF);
+        result |= ((uint32_t)diff & 0xFF) << (8 * i);
+        host_apsr_ge |= (uint32_t)(diff >= 0) << i;
+    }
+    return result;
+}
+
+// GE[i] 为1时取 op1 的第 i 个字节，否则取 op2 的
+static inline uint32_t __SEL(uint32_t op1, uint32_t op2)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t byte_mask = 0xFFu << (8 * i);
+        result |= ((host_apsr_ge >> i) & 1) ? (op1 & byte_mask) : (op2 & byte_mask);
+    }
+    return result;
+}
+
+// 4个字节差的绝对值之和
+static inline uint32_t __USAD8(uint32_t op1, uint32_t op2)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        int diff = (int)((op1 >> (8 * i)) & 0xFF) - (int)((op2 >> (8 * i)) & 0xFF);
+        sum += (uint32_t)(diff < 0 ? -diff : diff);
+    }
+    return sum;
+}
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        result |= ((value >> i) & 1u) << (31 - i);
+    }
+    return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+    uint8_t n = 0;
+    while (n < 32 && !(value & (0x80000000u >> n)))
+    {
+        n++;
+    }
+    return n;
+}
+
+#endif
\ No newline at end of file
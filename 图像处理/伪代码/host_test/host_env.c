@@ -0,0 +1,18 @@
+#include <time.h>
+#include "host_env.h"
+
+uint8_t mt9v03x_image_copy[120][188];
+
+uint32_t host_cycle_counter(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)((uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec);
+}
+
+double host_seconds(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
\ No newline at end of file
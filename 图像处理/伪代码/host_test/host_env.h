@@ -0,0 +1,15 @@
+#ifndef __HOST_ENV_H__
+#define __HOST_ENV_H__
+
+// 主机端编译环境：编译各章节时用 -include 强制包含，代替单片机工程中的摄像头驱动头文件和周期计数器。
+#include <stdint.h>
+#include <stdbool.h>
+
+extern uint8_t mt9v03x_image_copy[120][188]; // 摄像头驱动提供的图像副本，主机端定义在 host_env.c
+
+uint32_t host_cycle_counter(void);           // 单调时钟的纳秒数（截断为32位），代替 DWT->CYCCNT
+double   host_seconds(void);                 // 单调时钟的秒数，供基准测试计时
+
+#define IMAGE_CYCLE_COUNTER() host_cycle_counter()
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef __HOST_PIPELINE_H__
+#define __HOST_PIPELINE_H__
+
+// 各测试共用的参考流程。必须在被测章节源码之后包含：类型（point、BinaryFrame、TrackContext 等）
+// 和方向表 grow_l / grow_r 都来自该章节，调用的函数由前面章节的目标文件提供。
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      轮廓跟踪参考路径：search_line_packed + 行地图转换
+// 参数说明      frame         本帧的压缩二值图
+// 参数说明      context       输出 left_edge / right_edge 的原始点和行地图
+// 参数说明      left          get_start_point_packed 给出的左起点
+// 参数说明      right         get_start_point_packed 给出的右起点
+// 备注信息      起点由 adjust_start_point_for_trace 移到跟踪器的出发点，与各章节主流程相同。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void host_trace_packed(const BinaryFrame *frame, TrackContext *context, point left, point right)
+{
+    EdgeTracker *l = &context->left_edge;
+    EdgeTracker *r = &context->right_edge;
+
+    adjust_start_point_for_trace(&left, &right);
+    l->start_point = left;
+    r->start_point = right;
+    l->grow_table = grow_l;
+    r->grow_table = grow_r;
+    search_line_packed(frame, l, r, MAX_EDGE_POINTS * 2);
+
+    l->mapped_edge_start_y = r->mapped_edge_start_y = left.y;
+    l->mapped_edge_end_y = convert_edge_to_row_map_first_point(l->raw_edge_points, l->raw_points_count + 1, l->mapped_edge);
+    r->mapped_edge_end_y = convert_edge_to_row_map_first_point(r->raw_edge_points, r->raw_points_count + 1, r->mapped_edge);
+}
+
+#endif
\ No newline at end of file
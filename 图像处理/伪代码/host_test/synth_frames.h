@@ -0,0 +1,265 @@
+#ifndef __SYNTH_FRAMES_H__
+#define __SYNTH_FRAMES_H__
+
+// 合成测试帧：生成 188x120 的 0/255 灰度图，四周一圈为黑。
+// 仓库里没有实录的摄像头帧，各基准都用这里的固定种子序列，结果可以复现（使用 C 库 rand）。
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define SYNTH_W 188
+#define SYNTH_H 120
+
+static inline void synth_black_border(uint8_t *img)
+{
+    for (int x = 0; x < SYNTH_W; x++)
+    {
+        img[x] = 0;
+        img[(SYNTH_H - 1) * SYNTH_W + x] = 0;
+    }
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        img[y * SYNTH_W] = 0;
+        img[y * SYNTH_W + SYNTH_W - 1] = 0;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      弯道：中心随行号二次变化，宽度近大远小，随机 0~3 级椒盐噪声
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_curve(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 60 + rand() % 60, w = 80 + rand() % 40;
+    double curv = ((rand() % 200) - 100) / 4000.0;
+    int noise = rand() % 4;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        int c = (int)(cx + curv * dy * dy);
+        int ww = (int)(w * (0.3 + 0.7 * y / (SYNTH_H - 1.0)));
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            int v = (x >= c - ww / 2 && x <= c + ww / 2) ? 255 : 0;
+            if (x == 0 || x == SYNTH_W - 1 || y == 0 || y == SYNTH_H - 1) v = 0;
+            if (noise && rand() % (400 / noise) == 0) v = 255 - v;
+            img[y * SYNTH_W + x] = (uint8_t)v;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      直道：中心不变，宽度每 30 行收窄一次，边界大部分是竖直段
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_vertical(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 80 + rand() % 30, w = 100 + rand() % 30;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        int ww = w - ((SYNTH_H - 1 - y) / 30) * 10;
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= cx - ww / 2 && x <= cx + ww / 2) ? 255 : 0;
+        }
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      直角弯：赛道向上后向右拐，外侧边界有长水平段
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_corner(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 70 + rand() % 20, w = 50 + rand() % 10, top = 30 + rand() % 20;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            int v = 0;
+            if (y >= top && x >= cx - w / 2 && x <= cx + w / 2) v = 255;
+            if (y >= top - w / 2 - 10 && y < top + w / 2 - 10 && x >= cx - w / 2) v = 255;
+            img[y * SYNTH_W + x] = (uint8_t)v;
+        }
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      十字路口：近似直道加一条贯穿全宽的横向白带，边界在白带处沿水平方向行走
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_crossing(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 80 + rand() % 30, w = 150;
+    double curv = ((rand() % 100) - 50) / 1e5 * 0.6;
+    int band_y = 40 + rand() % 20, band_h = 20 + rand() % 10;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        int c = (int)(cx + curv * dy * dy);
+        int ww = w * (y + 4) / 123;
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            int v = (x >= c - ww / 2 && x <= c + ww / 2) ? 255 : 0;
+            if (y >= band_y && y <= band_y + band_h) v = 255;
+            img[y * SYNTH_W + x] = (uint8_t)v;
+        }
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      S 弯：中心随行号按正弦摆动 (0.8~1.5 个周期)，宽度近大远小，无噪声
+// 备注信息      边线曲率在帧内换号，单条三阶曲线拟合不好，用于分段拟合和参数化的比较。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_s_curve(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 80 + rand() % 30, w = 90 + rand() % 30;
+    double amp = 12 + rand() % 15, periods = 0.8 + (rand() % 8) / 10.0, phase = (rand() % 628) / 100.0;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        double c = cx + amp * (sin(2 * M_PI * periods * dy / SYNTH_H + phase) - sin(phase));
+        double ww = w * (0.4 + 0.6 * y / (SYNTH_H - 1.0));
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= c - ww / 2 && x <= c + ww / 2) ? 255 : 0;
+        }
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      灰度弯道：赛道 190、背景 50，整体乘以 light_percent% 的亮度后加 ±10 的均匀噪声
+// 备注信息      与其它生成函数不同，输出不是 0/255 二值图，用于需要直方图和自适应阈值的测试。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_grey_track(uint8_t *img, int seed, int light_percent)
+{
+    srand(seed);
+    int cx = 80 + rand() % 30;
+    double curv = ((rand() % 100) - 50) / 1e5 * 0.6;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        double c = cx + curv * dy * dy, w = 150 * (y + 4) / 123.0;
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            int v = (x >= c - w / 2 && x <= c + w / 2) ? 190 : 50;
+            v = v * light_percent / 100 + rand() % 21 - 10;
+            img[y * SYNTH_W + x] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+        }
+    }
+    synth_black_border(img);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      椒盐噪声弯道：与 synth_curve 同形状的干净赛道，再随机翻转 flips 个像素
+// 备注信息      约三分之一的翻转点把右侧相邻像素也改成同色，得到 1x2 的噪点。seed 相同、flips 为0时就是干净帧。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_salt_track(uint8_t *img, int seed, int flips)
+{
+    srand(seed);
+    int cx = 60 + rand() % 60, w = 80 + rand() % 40;
+    double curv = ((rand() % 200) - 100) / 4000.0;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        int c = (int)(cx + curv * dy * dy);
+        int ww = (int)(w * (0.3 + 0.7 * y / (SYNTH_H - 1.0)));
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= c - ww / 2 && x <= c + ww / 2) ? 255 : 0;
+        }
+    }
+    synth_black_border(img);
+    for (int k = 0; k < flips; k++)
+    {
+        int p = rand() % (SYNTH_H * SYNTH_W);
+        img[p] ^= 255;
+        if (rand() % 3 == 0 && p + 1 < SYNTH_H * SYNTH_W)
+        {
+            img[p + 1] = img[p];
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      带干扰块的弯道：底部两侧贴着边框放 blobs 个白块，再随机翻转 flips 个像素
+// 参数说明      true_left / true_right  输出第 118 行赛道的真实左右白像素 x（已夹到 [1, 186]）
+// 备注信息      白块模拟场地边上的反光，它们落在起点搜索的范围内，但不与赛道连通（除非随机位置正好贴上）。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_blob_track(uint8_t *img, int seed, int blobs, int flips, int *true_left, int *true_right)
+{
+    srand(seed);
+    int cx = 60 + rand() % 60, w = 80 + rand() % 40;
+    double curv = ((rand() % 200) - 100) / 4000.0;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        int c = (int)(cx + curv * dy * dy);
+        int ww = (int)(w * (0.3 + 0.7 * y / (SYNTH_H - 1.0)));
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= c - ww / 2 && x <= c + ww / 2) ? 255 : 0;
+        }
+        if (y == SYNTH_H - 2)
+        {
+            *true_left = c - ww / 2;
+            *true_right = c + ww / 2;
+        }
+    }
+    for (int b = 0; b < blobs; b++)
+    {
+        int bw = 12 + rand() % 10, bh = 2 + rand() % 4;
+        int bx = (rand() & 1) ? 1 + rand() % 8 : SYNTH_W - 1 - bw - rand() % 8;
+        int by = SYNTH_H - 2 - bh + 1 - rand() % 3;
+        for (int y = by; y < by + bh; y++)
+        {
+            for (int x = bx; x < bx + bw; x++)
+            {
+                img[y * SYNTH_W + x] = 255;
+            }
+        }
+    }
+    for (int k = 0; k < flips; k++)
+    {
+        img[rand() % (SYNTH_H * SYNTH_W)] ^= 255;
+    }
+    synth_black_border(img);
+    if (*true_left < 1) *true_left = 1;
+    if (*true_right > SYNTH_W - 2) *true_right = SYNTH_W - 2;
+}
+
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      连续帧弯道：第 t 帧的中心、弯曲程度和宽度随 t 缓慢变化，相邻帧边线最多移动一两个像素，随机翻转 0~29 个像素
+// 备注信息      用于依赖上一帧结果的算法 (起点跟踪、ROI 走廊等)；t 相同时输出相同。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void synth_drift(uint8_t *img, int t)
+{
+    double cx = 94 + 30 * sin(t * 0.013) + 8 * sin(t * 0.071);
+    double curv = 0.012 * sin(t * 0.009);
+    double w = 100 + 20 * sin(t * 0.005);
+
+    srand(t);
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double dy = SYNTH_H - 1 - y;
+        double c = cx + curv * dy * dy;
+        double half = w * (0.3 + 0.7 * y / (SYNTH_H - 1.0)) / 2;
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= c - half && x <= c + half) ? 255 : 0;
+        }
+    }
+    for (int k = rand() % 30; k > 0; k--)
+    {
+        img[rand() % (SYNTH_H * SYNTH_W)] ^= 255;
+    }
+    synth_black_border(img);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+// 第1章 SWAR 起点搜索的一致性测试与耗时基准
+// 对每一帧分别调用 get_start_point 和 get_start_point_swar，要求返回值以及 p_left / p_right 逐字节相同
+// (包括返回 false 时两个输出中残留的值，调用前两边填入同样的哨兵值)，并统计两者的耗时。
+// 除了合成赛道，还用随机像素帧覆盖各种“黑,黑,白,白”组合、非 0/255 的灰度值和找不到起点的情况。
+// 主机上 image_kernels.c 走纯C实现，这里的耗时反映的是字级并行本身，不含 M4 的 DSP 指令。
+// 用法：test_ch01_swar [每类帧数，默认2000]
+#include <stdio.h>
+#include <string.h>
+#include "../image_processing_01.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+
+// 每个像素随机取黑、白或中间灰度，行内跳变密集，宽度校验经常不通过
+static void gen_random(uint8_t *img, int seed)
+{
+    static const uint8_t levels[4] = { IMAGE_BLACK, IMAGE_WHITE, 128, IMAGE_WHITE };
+    srand(seed);
+    for (int i = 0; i < SYNTH_H * SYNTH_W; i++)
+    {
+        img[i] = levels[rand() & 3];
+    }
+}
+
+// 大部分为黑，只有零星的白色短段，多数帧找不到起点
+static void gen_sparse(uint8_t *img, int seed)
+{
+    srand(seed);
+    for (int i = 0; i < SYNTH_H * SYNTH_W; i++)
+    {
+        img[i] = IMAGE_BLACK;
+    }
+    for (int k = rand() % 40; k > 0; k--)
+    {
+        int p = rand() % (SYNTH_H * SYNTH_W - 3);
+        int n = 1 + rand() % 3;
+        for (int i = 0; i < n; i++)
+        {
+            img[p + i] = IMAGE_WHITE;
+        }
+    }
+}
+
+static void gen_curve(uint8_t *img, int seed)    { synth_curve(img, seed); }
+static void gen_vertical(uint8_t *img, int seed) { synth_vertical(img, seed); }
+static void gen_corner(uint8_t *img, int seed)   { synth_corner(img, seed); }
+
+// 返回不一致的帧数
+static int check_set(const char *name, FrameGenerator gen, int frames)
+{
+    int found = 0, mismatched = 0;
+    double t_scalar = 0, t_swar = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        point l0 = { 0xA5, 0x5A }, r0 = { 0xC3, 0x3C };
+        point l1 = l0, r1 = r0;
+        gen(image, s);
+
+        bool ok0 = get_start_point(image, &l0, &r0);
+        bool ok1 = get_start_point_swar(image, &l1, &r1);
+        found += ok0;
+        if (ok0 != ok1 || memcmp(&l0, &l1, sizeof(point)) != 0 || memcmp(&r0, &r1, sizeof(point)) != 0)
+        {
+            if (mismatched < 5)
+            {
+                printf("  %s seed %d: scalar %d L(%d,%d) R(%d,%d), swar %d L(%d,%d) R(%d,%d)\n", name, s,
+                       ok0, l0.x, l0.y, r0.x, r0.y, ok1, l1.x, l1.y, r1.x, r1.y);
+            }
+            mismatched++;
+        }
+
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            get_start_point(image, &l0, &r0);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            get_start_point_swar(image, &l1, &r1);
+        }
+        double t2 = host_seconds();
+        t_scalar += t1 - t0;
+        t_swar += t2 - t1;
+    }
+
+    double per_frame = 1e6 / ((double)frames * REPEAT);
+    printf("%-10s %5d frames, found %5d, mismatched %d | scalar %.2f us, swar %.2f us (x%.2f)\n", name, frames,
+           found, mismatched, t_scalar * per_frame, t_swar * per_frame, t_scalar / t_swar);
+    return mismatched;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    int mismatched = 0;
+
+    mismatched += check_set("curve", gen_curve, frames);
+    mismatched += check_set("vertical", gen_vertical, frames);
+    mismatched += check_set("corner", gen_corner, frames);
+    mismatched += check_set("random", gen_random, frames);
+    mismatched += check_set("sparse", gen_sparse, frames);
+
+    if (mismatched)
+    {
+        printf("FAIL: get_start_point_swar differs from get_start_point in %d frames\n", mismatched);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
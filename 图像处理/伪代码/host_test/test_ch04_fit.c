@@ -0,0 +1,192 @@
+// 第4章 贝塞尔拟合的零堆内存测试
+// 链接时用 -Wl,--wrap 截获 malloc / calloc / realloc / free，统计以下调用期间的堆操作次数，必须为0：
+// 1. fit_bezier_curve 单独拟合随机边线；
+// 2. 合成帧上从起点搜索、循迹、提纯到 fit_edges_with_bezier 的整条流程 (与修正后的各章节主流程相同：起点移到跟踪器出发点，
+//    从起点行开始提纯)，并要求大部分帧确实拟合出了曲线。
+// 同时与改动前先 malloc 两个数组、再逐点求 t 值的实现比较，四个控制点必须逐位相同，并统计两者的耗时。
+// 用法：test_ch04_fit [边线条数，默认20000]
+#include <stdio.h>
+#include "../image_processing_04.c"
+#include "synth_frames.h"
+
+#define REPEAT 10 // 计时时每条边线重复的次数
+
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+void __real_free(void *p);
+
+// 不能是 static：否则编译器认为外部的 malloc 不会修改它，把调用前后的计数优化成常量
+volatile long heap_calls;
+
+void *__wrap_malloc(size_t size)            { heap_calls++; return __real_malloc(size); }
+void *__wrap_calloc(size_t n, size_t size)  { heap_calls++; return __real_calloc(n, size); }
+void *__wrap_realloc(void *p, size_t size)  { heap_calls++; return __real_realloc(p, size); }
+void __wrap_free(void *p)                   { heap_calls++; __real_free(p); }
+
+// 改动前的实现：先把点和 t 值存进 malloc 的数组，再归一化、累加最小二乘和
+static CubicBezier fit_bezier_curve_malloc(const point *points, int count)
+{
+    CubicBezier bezier;
+    if (count < 2) {
+        bezier.p0 = bezier.p1 = bezier.p2 = bezier.p3 = (point_f){0, 0};
+        return bezier;
+    }
+
+    point_f *points_f = (point_f *)malloc(count * sizeof(point_f));
+    for (int i = 0; i < count; i++) {
+        points_f[i] = (point_f){(float)points[i].x, (float)points[i].y};
+    }
+    bezier.p0 = points_f[0];
+    bezier.p3 = points_f[count - 1];
+
+    float *t_values = (float *)malloc(count * sizeof(float));
+    t_values[0] = 0.0f;
+    float total_length = 0;
+    for (int i = 1; i < count; i++) {
+        total_length += sqrtf(distance_sq(points_f[i], points_f[i - 1]));
+        t_values[i] = total_length;
+    }
+    for (int i = 1; i < count; i++) {
+        t_values[i] /= total_length;
+    }
+
+    float C[2][2] = {{0, 0}, {0, 0}};
+    point_f X[2] = {{0, 0}, {0, 0}};
+    for (int i = 0; i < count; i++) {
+        float t = t_values[i];
+        float t_inv = 1.0f - t;
+        float b0 = t_inv * t_inv * t_inv;
+        float b1 = 3.0f * t * t_inv * t_inv;
+        float b2 = 3.0f * t * t * t_inv;
+        float b3 = t * t * t;
+        C[0][0] += b1 * b1;
+        C[0][1] += b1 * b2;
+        C[1][1] += b2 * b2;
+        point_f d_prime = {
+            points_f[i].x - (b0 * bezier.p0.x + b3 * bezier.p3.x),
+            points_f[i].y - (b0 * bezier.p0.y + b3 * bezier.p3.y)
+        };
+        X[0].x += b1 * d_prime.x;
+        X[0].y += b1 * d_prime.y;
+        X[1].x += b2 * d_prime.x;
+        X[1].y += b2 * d_prime.y;
+    }
+    C[1][0] = C[0][1];
+
+    float det_C = C[0][0] * C[1][1] - C[0][1] * C[1][0];
+    if (fabsf(det_C) > 1e-6) {
+        float det_C_inv = 1.0f / det_C;
+        bezier.p1.x = det_C_inv * (X[0].x * C[1][1] - X[1].x * C[0][1]);
+        bezier.p1.y = det_C_inv * (X[0].y * C[1][1] - X[1].y * C[0][1]);
+        bezier.p2.x = det_C_inv * (X[1].x * C[0][0] - X[0].x * C[1][0]);
+        bezier.p2.y = det_C_inv * (X[1].y * C[0][0] - X[0].y * C[1][0]);
+    } else {
+        bezier.p1 = (point_f){bezier.p0.x * (2.0f/3.0f) + bezier.p3.x * (1.0f/3.0f),
+                              bezier.p0.y * (2.0f/3.0f) + bezier.p3.y * (1.0f/3.0f)};
+        bezier.p2 = (point_f){bezier.p0.x * (1.0f/3.0f) + bezier.p3.x * (2.0f/3.0f),
+                              bezier.p0.y * (1.0f/3.0f) + bezier.p3.y * (2.0f/3.0f)};
+    }
+
+    free(points_f);
+    free(t_values);
+    return bezier;
+}
+
+// 像提纯结果一样自下而上逐行的边线，x 随机游走；每隔若干条生成点数很少或所有点都不动的退化边线
+static int random_edge(point *pts, int seed)
+{
+    srand(seed);
+    int count = seed % 17 == 0 ? 2 + rand() % 3 : 4 + rand() % (IMAGE_H - 6);
+    bool still = seed % 29 == 0;
+    int x = 20 + rand() % 140, y = IMAGE_H - 2;
+    for (int i = 0; i < count; i++)
+    {
+        pts[i].x = (uint8_t)x;
+        pts[i].y = (uint8_t)y;
+        if (!still)
+        {
+            x += rand() % 5 - 2;
+            x = x < 1 ? 1 : (x > IMAGE_W - 2 ? IMAGE_W - 2 : x);
+            y -= 1 + (rand() % 8 == 0);
+            y = y < 1 ? 1 : y;
+        }
+    }
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    int edges = argc > 1 ? atoi(argv[1]) : 20000;
+    static point pts[IMAGE_H];
+    static TrackContext context;
+    long fit_heap = 0, main_heap = 0;
+    int differ = 0, traced = 0;
+    double t_ref = 0, t_new = 0;
+
+    // --- 1. 单独拟合 ---
+    for (int s = 0; s < edges; s++)
+    {
+        int count = random_edge(pts, s);
+        CubicBezier ref = fit_bezier_curve_malloc(pts, count);
+
+        heap_calls = 0;
+        CubicBezier fit = fit_bezier_curve(pts, count);
+        fit_heap += heap_calls;
+
+        if (memcmp(&ref, &fit, sizeof(CubicBezier)) != 0)
+        {
+            if (differ < 5)
+            {
+                printf("  edge %d (%d points): P1 (%g,%g) vs (%g,%g), P2 (%g,%g) vs (%g,%g)\n", s, count,
+                       ref.p1.x, ref.p1.y, fit.p1.x, fit.p1.y, ref.p2.x, ref.p2.y, fit.p2.x, fit.p2.y);
+            }
+            differ++;
+        }
+
+        volatile float sink = 0;
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) sink += fit_bezier_curve_malloc(pts, count).p1.x;
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) sink += fit_bezier_curve(pts, count).p1.x;
+        double t2 = host_seconds();
+        t_ref += t1 - t0;
+        t_new += t2 - t1;
+    }
+
+    // --- 2. 整条流程 ---
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    context.left_edge.threshold = context.right_edge.threshold = 128;
+    for (int s = 0; s < 500; s++)
+    {
+        uint8_t *image = mt9v03x_image_copy[0];
+        synth_curve(image, s);
+        synth_black_border(image); // 灰度版循迹依赖黑边框
+        heap_calls = 0;
+        if (get_start_point(image, &context.left_edge.start_point, &context.right_edge.start_point))
+        {
+            adjust_start_point_for_trace(&context.left_edge.start_point, &context.right_edge.start_point);
+            search_line(image, &context.left_edge, &context.right_edge, MAX_EDGE_POINTS * 2);
+            context.left_edge.mapped_edge_start_y = context.right_edge.mapped_edge_start_y = context.left_edge.start_point.y;
+            extract_and_filter_edges(&context);
+            fit_edges_with_bezier(&context);
+            traced += context.left_bezier_found && context.right_bezier_found;
+        }
+        main_heap += heap_calls;
+    }
+
+    double per_edge = 1e6 / ((double)edges * REPEAT);
+    printf("%d edges: bit-identical to the malloc version except %d, heap calls in fit_bezier_curve %ld | "
+           "malloc version %.2f us, streaming %.2f us\n", edges, differ, fit_heap, t_ref * per_edge, t_new * per_edge);
+    printf("500 frames from start point to fit (%d with both curves fitted): heap calls %ld\n", traced, main_heap);
+
+    if (differ || fit_heap || main_heap || traced < 400)
+    {
+        printf("FAIL: fit_bezier_curve uses the heap or differs from the malloc version\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,161 @@
+// 第5章 压缩二值图的逐像素一致性测试与耗时基准
+// 1. binarize_and_pack：灰度帧在随机阈值下压缩，每个像素的位必须等于 (灰度 > 阈值)，每行末字的填充位必须为0；
+// 2. get_start_point_packed 与 get_start_point、search_line_packed 与 search_line：灰度帧按同一阈值化成 0/255 后，
+//    两条路径的起点、原始边缘点、方向和点数必须完全相同 (灰度版循迹依赖黑边框，测试帧都带黑边框)；
+// 3. 两条路径各阶段的耗时：整帧阈值化为 0/255 与二值化压缩、起点搜索、轮廓跟踪。
+//    主机上压缩走 image_kernels.c 的纯C实现，阈值化循环则会被编译器向量化，两者的比值与 M4 上不同。
+// 用法：test_ch05_packed [每类帧数，默认1000]
+#include <stdio.h>
+#include "../image_processing_05.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+bool get_start_point(const uint8_t *image, point *p_left, point *p_right); // 实现见 image_processing_01.c
+void search_line(const uint8_t *image, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_02.c
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static uint8_t grey[SYNTH_H * SYNTH_W];
+static uint8_t binary[SYNTH_H * SYNTH_W]; // grey 按阈值化成的 0/255 图，灰度版流程的输入
+static TrackContext byte_ctx, packed_ctx;
+
+static void gen_grey(uint8_t *img, int seed)  { synth_grey_track(img, seed, 60 + seed % 80); }
+// synth_curve 的噪声会落在边框上；灰度版循迹依赖黑边框 (越界读相邻内存)，压缩版把图像外当作黑色，
+// 边框被噪声打白时两者本来就不同，所以这里补回黑边框
+static void gen_curve(uint8_t *img, int seed)
+{
+    synth_curve(img, seed);
+    synth_black_border(img);
+}
+
+static void threshold_frame(uint8_t threshold)
+{
+    for (int i = 0; i < SYNTH_H * SYNTH_W; i++)
+    {
+        binary[i] = grey[i] > threshold ? IMAGE_WHITE : IMAGE_BLACK;
+    }
+}
+
+// 返回不一致的像素数
+static long compare_pixels(uint8_t threshold)
+{
+    long wrong = 0;
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            wrong += BIN_PIXEL(&binary_frame, x, y) != (grey[y * IMAGE_W + x] > threshold);
+        }
+        wrong += (binary_frame.row[y][BIN_ROW_WORDS - 1] & ~BIN_LAST_WORD_MASK) != 0;
+    }
+    return wrong;
+}
+
+static bool same_trace(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->raw_points_count == b->raw_points_count &&
+           memcmp(a->raw_edge_points, b->raw_edge_points, (a->raw_points_count + 1) * sizeof(point)) == 0 &&
+           memcmp(a->raw_direction, b->raw_direction, a->raw_points_count + 1) == 0;
+}
+
+static void begin_trace(TrackContext *context, point left, point right)
+{
+    adjust_start_point_for_trace(&left, &right);
+    context->left_edge.start_point = left;
+    context->right_edge.start_point = right;
+    context->left_edge.grow_table = grow_l;
+    context->right_edge.grow_table = grow_r;
+    context->left_edge.threshold = context->right_edge.threshold = 128; // 0/255 图上的灰度版判断阈值
+}
+
+// 返回不一致的帧数
+static int check_set(const char *name, FrameGenerator gen, int frames)
+{
+    long wrong_pixels = 0;
+    int found = 0, start_diff = 0, trace_diff = 0;
+    double t_bin = 0, t_pack = 0, t_start = 0, t_start_packed = 0, t_trace = 0, t_trace_packed = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        const uint8_t threshold = (uint8_t)(40 + s * 37 % 180);
+        point l0 = { 0 }, r0 = { 0 }, l1 = { 0 }, r1 = { 0 };
+
+        gen(grey, s);
+        binarize_and_pack(grey, threshold, &binary_frame);
+        threshold_frame(threshold);
+        wrong_pixels += compare_pixels(threshold);
+
+        bool ok0 = get_start_point(binary, &l0, &r0);
+        bool ok1 = get_start_point_packed(&binary_frame, &l1, &r1);
+        if (ok0 != ok1 || memcmp(&l0, &l1, sizeof(point)) != 0 || memcmp(&r0, &r1, sizeof(point)) != 0)
+        {
+            start_diff++;
+            continue;
+        }
+        if (!ok0)
+        {
+            continue;
+        }
+        found++;
+
+        begin_trace(&byte_ctx, l0, r0);
+        begin_trace(&packed_ctx, l1, r1);
+        search_line(binary, &byte_ctx.left_edge, &byte_ctx.right_edge, MAX_EDGE_POINTS * 2);
+        search_line_packed(&binary_frame, &packed_ctx.left_edge, &packed_ctx.right_edge, MAX_EDGE_POINTS * 2);
+        if (!same_trace(&byte_ctx.left_edge, &packed_ctx.left_edge) || !same_trace(&byte_ctx.right_edge, &packed_ctx.right_edge))
+        {
+            if (trace_diff < 5)
+            {
+                printf("  %s seed %d: traces differ (L %d/%d points, R %d/%d points)\n", name, s,
+                       byte_ctx.left_edge.raw_points_count, packed_ctx.left_edge.raw_points_count,
+                       byte_ctx.right_edge.raw_points_count, packed_ctx.right_edge.raw_points_count);
+            }
+            trace_diff++;
+        }
+
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) threshold_frame(threshold);
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) binarize_and_pack(grey, threshold, &binary_frame);
+        double t2 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) get_start_point(binary, &l0, &r0);
+        double t3 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) get_start_point_packed(&binary_frame, &l1, &r1);
+        double t4 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) search_line(binary, &byte_ctx.left_edge, &byte_ctx.right_edge, MAX_EDGE_POINTS * 2);
+        double t5 = host_seconds();
+        for (int k = 0; k < REPEAT; k++) search_line_packed(&binary_frame, &packed_ctx.left_edge, &packed_ctx.right_edge, MAX_EDGE_POINTS * 2);
+        double t6 = host_seconds();
+        t_bin += t1 - t0;
+        t_pack += t2 - t1;
+        t_start += t3 - t2;
+        t_start_packed += t4 - t3;
+        t_trace += t5 - t4;
+        t_trace_packed += t6 - t5;
+    }
+
+    double per_frame = found ? 1e6 / ((double)found * REPEAT) : 0;
+    printf("%-6s %4d frames, traced %4d | wrong pixels %ld, start points differ %d, traces differ %d\n",
+           name, frames, found, wrong_pixels, start_diff, trace_diff);
+    printf("%-6s threshold %.2f -> pack %.2f us, start %.2f -> %.2f us, trace %.2f -> %.2f us\n", name,
+           t_bin * per_frame, t_pack * per_frame, t_start * per_frame, t_start_packed * per_frame,
+           t_trace * per_frame, t_trace_packed * per_frame);
+    return (wrong_pixels != 0) + start_diff + trace_diff;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 1000;
+    int failed = 0;
+
+    failed += check_set("grey", gen_grey, frames);
+    failed += check_set("curve", gen_curve, frames);
+
+    if (failed)
+    {
+        printf("FAIL: the packed frame differs from the byte pipeline\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+// 第8章 带帧间跟踪的起点搜索与全图扫描的一致性测试
+// 连续帧中赛道左右平移、宽度缓慢变化，带椒盐噪点，并且不时有几帧底部被横条遮挡 (起点被迫上移，之后又回到底部)。
+// 每一帧 get_start_point_seeded 的结果与 get_start_point、get_start_point_packed 的全图扫描比较：
+// 1. 两种全图扫描必须完全相同；走慢速路径的帧，get_start_point_seeded 也必须与它们完全相同；
+// 2. 快速路径命中的帧，与全图扫描的差别只能是 get_start_point_seeded 注释中列出的两种：
+//    a. 命中行内窗口左侧还有匹配：全图扫描在这一行取到的左右x都不大于快速路径的 (噪点在赛道外)；
+//    b. 命中行与全图扫描在这一行的结果相同，但全图扫描的行更靠下 (遮挡消失)，而且最多持续 START_SEED_REFRESH_FRAMES 帧；
+//    除此之外行号和x都必须相同。
+// 另外统计快速路径的命中率、每次命中读取的像素数以及两种差别各出现的帧数。
+// 用法：test_ch08_seeded [帧数，默认3000]
+#include <stdio.h>
+#include "../image_processing_08.c"
+#include "synth_frames.h"
+
+// 与 image_processing_05.c 的 BinaryFrame 布局相同，第8章本身不使用压缩帧
+typedef struct {
+    uint32_t row[IMAGE_H][(IMAGE_W + 31) / 32];
+    uint8_t  threshold;
+} PackedFrame;
+
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, PackedFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const PackedFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static PackedFrame packed;
+
+// 第 t 帧：中心和宽度随时间缓慢变化，每 97 帧中有 6 帧底部 3~14 行被遮挡，遮挡消失后的 4 帧中间隔一行有一条横穿赛道的黑线；
+// 每 7 帧在底部三行、赛道左侧放一个 2 像素的白色噪点
+static void gen_drift(uint8_t *img, int t)
+{
+    double c = 94 + 40 * sin(t * 0.013) + 12 * sin(t * 0.071);
+    double w = 70 + 30 * sin(t * 0.005);
+    int covered = (t % 97) < 6 ? 3 + (t / 97) % 12 : 0;
+    int stripe = (t % 97) >= 6 && (t % 97) < 10 ? SYNTH_H - 4 - (t / 97) % 8 : -1;
+
+    srand(t);
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double half = w * (y + 30) / 150.0 / 2;
+        double cy = c + 0.002 * (t % 200 - 100) * (SYNTH_H - 1 - y) * (SYNTH_H - 1 - y) / 10;
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            bool white = x >= cy - half && x <= cy + half && y < SYNTH_H - 1 - covered && y != stripe;
+            img[y * SYNTH_W + x] = white ? IMAGE_WHITE : IMAGE_BLACK;
+        }
+    }
+    for (int k = rand() % 30; k > 0; k--)
+    {
+        int p = rand() % (SYNTH_H * SYNTH_W);
+        img[p] = img[p] ? IMAGE_BLACK : IMAGE_WHITE;
+    }
+    int left = (int)(c - w * (SYNTH_H - 2 + 30) / 150.0 / 2);
+    if (t % 7 == 0 && left > 12)
+    {
+        int p = (SYNTH_H - 2 - rand() % 3) * SYNTH_W + 3 + rand() % (left - 12);
+        img[p] = img[p + 1] = IMAGE_WHITE;
+    }
+    synth_black_border(img);
+}
+
+// 按 get_start_point 的规则检查一行：特殊情况优先，其余取最靠左的匹配
+static void reference_row(const uint8_t *img, int y, bool *l_found, bool *r_found, uint8_t *l_x, uint8_t *r_x)
+{
+    const uint8_t *row = img + y * IMAGE_W;
+    *l_found = row[1] == IMAGE_WHITE && row[2] == IMAGE_WHITE;
+    *r_found = row[IMAGE_W - 2] == IMAGE_WHITE && row[IMAGE_W - 3] == IMAGE_WHITE;
+    *l_x = 1;
+    *r_x = IMAGE_W - 2;
+    for (int x = 1; x < IMAGE_W - 3; x++)
+    {
+        if (!*l_found && !row[x] && !row[x + 1] && row[x + 2] && row[x + 3])
+        {
+            *l_found = true;
+            *l_x = (uint8_t)x;
+        }
+        if (!*r_found && row[x] && row[x + 1] && !row[x + 2] && !row[x + 3])
+        {
+            *r_found = true;
+            *r_x = (uint8_t)x;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 3000;
+    int found = 0, wrong = 0, speck_rows = 0, row_gap = 0, stale = 0;
+    long hit_reads = 0;
+    StartPointSeed seed = { 0 };
+
+    for (int t = 0; t < frames; t++)
+    {
+        point l0 = { 0 }, r0 = { 0 }, l1 = { 0 }, r1 = { 0 }, l2 = { 0 }, r2 = { 0 };
+        uint32_t hits_before = seed.hit_count;
+
+        gen_drift(image, t);
+        bool ok0 = get_start_point(image, &l0, &r0);
+        binarize_and_pack(image, 128, &packed);
+        bool ok1 = get_start_point_packed(&packed, &l1, &r1);
+        bool ok2 = get_start_point_seeded(image, &seed, &l2, &r2);
+        bool hit = seed.hit_count != hits_before;
+        bool same = ok0 == ok2 && (!ok0 || (memcmp(&l0, &l2, sizeof(point)) == 0 && memcmp(&r0, &r2, sizeof(point)) == 0));
+        hit_reads += hit ? seed.pixel_reads : 0;
+        found += ok0;
+
+        bool bad = ok0 != ok1 || (ok0 && (memcmp(&l0, &l1, sizeof(point)) != 0 || memcmp(&r0, &r1, sizeof(point)) != 0));
+        if (!hit || same)
+        {
+            bad |= !same;
+            stale = 0;
+        }
+        else
+        {
+            bool lf, rf;
+            uint8_t lx, rx;
+            reference_row(image, l2.y, &lf, &rf, &lx, &rx);
+            if (lf && rf && lx == l2.x && rx == r2.x)
+            {
+                // b. 这一行与全图扫描的规则一致，全图扫描只能是在更靠下的行找到了起点
+                bad |= !ok0 || l0.y <= l2.y || ++stale > START_SEED_REFRESH_FRAMES;
+                row_gap++;
+            }
+            else
+            {
+                // a. 窗口左侧还有匹配
+                bad |= !lf || !rf || lx > l2.x || rx > r2.x;
+                speck_rows++;
+            }
+        }
+        if (bad)
+        {
+            if (wrong < 5)
+            {
+                printf("  frame %d (%s): full %d L(%d,%d) R(%d,%d), packed %d L(%d,%d) R(%d,%d), seeded %d L(%d,%d) R(%d,%d)\n",
+                       t, hit ? "hit" : "scan", ok0, l0.x, l0.y, r0.x, r0.y, ok1, l1.x, l1.y, r1.x, r1.y,
+                       ok2, l2.x, l2.y, r2.x, r2.y);
+            }
+            wrong++;
+        }
+    }
+
+    printf("%d frames, found %d | fast path hits %u, full scans %u, %.1f reads per hit | "
+           "match left of the window %d, row above the full scan %d, unexplained %d\n",
+           frames, found, seed.hit_count, seed.miss_count, seed.hit_count ? (double)hit_reads / seed.hit_count : 0.0,
+           speck_rows, row_gap, wrong);
+    if (wrong)
+    {
+        printf("FAIL: get_start_point_seeded differs from the full scan\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
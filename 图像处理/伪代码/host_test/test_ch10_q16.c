@@ -0,0 +1,174 @@
+// 第10章 Q16 定点贝塞尔拟合的误差界与耗时基准
+// 1. div_q16：结果超出 int32_t 时必须返回false，范围内的结果与双精度计算的 floor 相同；
+// 2. 随机边线 (与提纯结果一样逐行向上、x 随机游走，含点数很少和所有点重合的退化边线) 与合成帧上真实的提纯结果，
+//    fit_bezier_curve_q16 与浮点 fit_bezier_curve 比较：控制点最大差值，以及两条曲线在 t 上均匀取 65 个点的最大距离，
+//    曲线距离不得超过 CURVE_TOLERANCE 像素；
+// 3. 两者每条边线的耗时。主机有 FPU，这里的比值不代表无 FPU 的副控板，那里浮点运算由软件库完成，定点版本的优势更大。
+// 用法：test_ch10_q16 [随机边线条数，默认20000]
+#include <stdio.h>
+#include "../image_processing_10.c"
+#include "synth_frames.h"
+
+#define REPEAT          10    // 计时时每条边线重复的次数
+#define CURVE_TOLERANCE 0.1f  // 定点与浮点曲线的最大允许距离 (像素)
+
+CubicBezier fit_bezier_curve(const point* points, int count); // 实现见 image_processing_04.c
+
+static point pts[IMAGE_H];
+static TrackContext context;
+
+typedef struct {
+    int   edges;
+    float max_control;   // 控制点坐标的最大差值
+    float max_curve;     // 曲线上对应点的最大距离
+    double sum_curve;    // 每条边线最大距离之和，用于求平均
+    double t_float, t_q16;
+} FitStats;
+
+static point_f bezier_at(const CubicBezier *b, float t)
+{
+    float u = 1.0f - t;
+    float b0 = u * u * u, b1 = 3 * t * u * u, b2 = 3 * t * t * u, b3 = t * t * t;
+    return (point_f){ b0 * b->p0.x + b1 * b->p1.x + b2 * b->p2.x + b3 * b->p3.x,
+                      b0 * b->p0.y + b1 * b->p1.y + b2 * b->p2.y + b3 * b->p3.y };
+}
+
+static float max_abs4(point_f a, point_f b, point_f c, point_f d)
+{
+    float m = fabsf(a.x - b.x);
+    m = fmaxf(m, fabsf(a.y - b.y));
+    m = fmaxf(m, fabsf(c.x - d.x));
+    return fmaxf(m, fabsf(c.y - d.y));
+}
+
+static void compare_fit(const point *p, int count, FitStats *st)
+{
+    CubicBezier f = fit_bezier_curve(p, count);
+    CubicBezierQ16 q = fit_bezier_curve_q16(p, count);
+    CubicBezier g = bezier_q16_to_float(&q);
+
+    float control = max_abs4(f.p1, g.p1, f.p2, g.p2);
+    float curve = 0;
+    for (int k = 0; k <= 64; k++)
+    {
+        point_f a = bezier_at(&f, k / 64.0f), b = bezier_at(&g, k / 64.0f);
+        curve = fmaxf(curve, hypotf(a.x - b.x, a.y - b.y));
+    }
+    st->edges++;
+    st->max_control = fmaxf(st->max_control, control);
+    st->max_curve = fmaxf(st->max_curve, curve);
+    st->sum_curve += curve;
+
+    volatile float sink = 0;
+    double t0 = host_seconds();
+    for (int k = 0; k < REPEAT; k++) sink += fit_bezier_curve(p, count).p1.x;
+    double t1 = host_seconds();
+    for (int k = 0; k < REPEAT; k++) sink += (float)fit_bezier_curve_q16(p, count).p1.x;
+    double t2 = host_seconds();
+    st->t_float += t1 - t0;
+    st->t_q16 += t2 - t1;
+}
+
+static bool report(const char *name, const FitStats *st)
+{
+    double per_edge = st->edges ? 1e6 / ((double)st->edges * REPEAT) : 0;
+    printf("%-8s %5d edges | max control diff %.4f px, curve diff max %.4f mean %.4f px | float %.2f us, q16 %.2f us\n",
+           name, st->edges, st->max_control, st->max_curve, st->edges ? st->sum_curve / st->edges : 0.0,
+           st->t_float * per_edge, st->t_q16 * per_edge);
+    return st->max_curve <= CURVE_TOLERANCE;
+}
+
+// 像提纯结果一样自下而上逐行的边线，x 随机游走；每隔若干条生成点数很少或所有点都不动的退化边线
+static int random_edge(point *p, int seed)
+{
+    srand(seed);
+    int count = seed % 17 == 0 ? 2 + rand() % 3 : 4 + rand() % (IMAGE_H - 6);
+    bool still = seed % 29 == 0;
+    int x = 20 + rand() % 140, y = IMAGE_H - 2;
+    for (int i = 0; i < count; i++)
+    {
+        p[i].x = (uint8_t)x;
+        p[i].y = (uint8_t)y;
+        if (!still)
+        {
+            x += rand() % 5 - 2;
+            x = x < 1 ? 1 : (x > IMAGE_W - 2 ? IMAGE_W - 2 : x);
+            y -= 1 + (rand() % 8 == 0);
+            y = y < 1 ? 1 : y;
+        }
+    }
+    return count;
+}
+
+// 返回出错的用例数
+static int check_div_q16(void)
+{
+    static const struct { int64_t num, den; } cases[] = {
+        { 0, 1 }, { 1, 3 }, { -1, 3 }, { 123456789, 4295 }, { -123456789, 4295 },
+        { (int64_t)1 << 50, (int64_t)1 << 40 }, { -((int64_t)1 << 50), (int64_t)1 << 40 },
+        { (int64_t)INT32_MAX, Q16_ONE }, { (int64_t)INT32_MIN, Q16_ONE },
+        { (int64_t)1 << 50, 4296 }, { -((int64_t)1 << 50), 4296 }, { (int64_t)1 << 31, 1 },
+    };
+    int wrong = 0;
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        int32_t out = 0x5A5A5A5A;
+        long double exact = (long double)cases[i].num * Q16_ONE / cases[i].den;
+        bool fits = exact > (long double)INT32_MIN - 1 && exact < (long double)INT32_MAX + 1;
+        bool ok = div_q16(cases[i].num, cases[i].den, &out);
+        // 整数除法向0取整
+        int64_t expect = (int64_t)exact;
+        if (ok != fits || (ok && out != expect) || (!ok && out != 0x5A5A5A5A))
+        {
+            printf("  div_q16(%lld, %lld): returned %d out %d, expected %d %lld\n", (long long)cases[i].num,
+                   (long long)cases[i].den, ok, out, fits, (long long)expect);
+            wrong++;
+        }
+    }
+    return wrong;
+}
+
+int main(int argc, char **argv)
+{
+    int edges = argc > 1 ? atoi(argv[1]) : 20000;
+    bool ok = true;
+
+    int div_wrong = check_div_q16();
+    printf("div_q16: %d wrong cases\n", div_wrong);
+    ok &= div_wrong == 0;
+
+    FitStats random = { 0 };
+    for (int s = 0; s < edges; s++)
+    {
+        compare_fit(pts, random_edge(pts, s), &random);
+    }
+    ok &= report("random", &random);
+
+    // 合成帧上真实的提纯结果
+    FitStats frames = { 0 };
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    for (int s = 0; s < 1000; s++)
+    {
+        synth_curve(mt9v03x_image_copy[0], s);
+        synth_black_border(mt9v03x_image_copy[0]); // 灰度版循迹依赖黑边框
+        context.left_edge.is_found = context.right_edge.is_found = false;
+        image_main_process(&context);
+        for (int side = 0; side < 2; side++)
+        {
+            const EdgeTracker *e = side ? &context.right_edge : &context.left_edge;
+            if (e->is_found && e->filtered_points_count >= 4)
+            {
+                compare_fit(e->filtered_edge, e->filtered_points_count, &frames);
+            }
+        }
+    }
+    ok &= report("frames", &frames) && frames.edges > 1500;
+
+    if (!ok)
+    {
+        printf("FAIL: the Q16 fit is off from the float fit by more than %.2f px\n", CURVE_TOLERANCE);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,147 @@
+// 第14章 直线段跳跃循迹与逐步循迹的一致性测试
+// 对直道、斜直道、直角弯、弯道、椒盐噪声弯道五组合成帧，在同一张压缩二值图上从同一起点
+// (get_start_point_packed 后移到跟踪器出发点) 分别运行 search_line_packed 和 search_line_gallop，
+// 迭代上限取主流程的 MAX_EDGE_POINTS * 2 以及两个较小值 (循环在中途被截断时回退超前点的路径)：
+// 1. 左右两边的点数、原始边缘点和方向必须逐项相同；
+// 2. 统计每帧实际跟踪次数 (gallop_stats.trace_calls) 与确认点数、跳跃命中率，以及两者的循迹耗时。
+// 用法：test_ch14_gallop [每组帧数，默认2000]
+#include <stdio.h>
+#include "../image_processing_14.c"
+#include "synth_frames.h"
+
+#define REPEAT 20 // 计时时每帧重复的次数
+
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static const uint16_t budgets[] = { MAX_EDGE_POINTS * 2, 150, 40 };
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext stepped, galloped;
+
+// 斜直道：左右边界都是斜率相同的直线，链码是 100100… 这样的周期序列而不是单一方向
+static void gen_slant(uint8_t *img, int seed)
+{
+    srand(seed);
+    int cx = 40 + rand() % 30, w = 70 + rand() % 30;
+    double slope = 0.3 + (rand() % 60) / 100.0;
+    for (int y = 0; y < SYNTH_H; y++)
+    {
+        double c = cx + slope * (SYNTH_H - 1 - y);
+        for (int x = 0; x < SYNTH_W; x++)
+        {
+            img[y * SYNTH_W + x] = (x >= c - w / 2 && x <= c + w / 2) ? IMAGE_WHITE : IMAGE_BLACK;
+        }
+    }
+    synth_black_border(img);
+}
+
+static void gen_salt(uint8_t *img, int seed)
+{
+    synth_salt_track(img, seed, 200);
+}
+
+static void begin_trace(TrackContext *context, point left, point right)
+{
+    context->left_edge.start_point = left;
+    context->right_edge.start_point = right;
+    context->left_edge.grow_table = grow_l;
+    context->right_edge.grow_table = grow_r;
+}
+
+static bool same_trace(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->raw_points_count == b->raw_points_count &&
+           memcmp(a->raw_edge_points, b->raw_edge_points, (a->raw_points_count + 1) * sizeof(point)) == 0 &&
+           memcmp(a->raw_direction, b->raw_direction, a->raw_points_count + 1) == 0 &&
+           memcmp(&a->current_point, &b->current_point, sizeof(point)) == 0;
+}
+
+// 返回不一致的帧数
+static int check_set(const char *name, FrameGenerator gen, int frames)
+{
+    int used = 0, differ = 0;
+    long points = 0, calls = 0, hits = 0, misses = 0;
+    double t_step = 0, t_gallop = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        point left, right;
+        gen(image, s);
+        binarize_and_pack(image, 128, &binary_frame);
+        if (!get_start_point_packed(&binary_frame, &left, &right))
+        {
+            continue;
+        }
+        adjust_start_point_for_trace(&left, &right);
+        begin_trace(&stepped, left, right);
+        begin_trace(&galloped, left, right);
+        used++;
+
+        for (unsigned b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++)
+        {
+            search_line_packed(&binary_frame, &stepped.left_edge, &stepped.right_edge, budgets[b]);
+            search_line_gallop(&binary_frame, &galloped.left_edge, &galloped.right_edge, budgets[b]);
+            if (!same_trace(&stepped.left_edge, &galloped.left_edge) || !same_trace(&stepped.right_edge, &galloped.right_edge))
+            {
+                if (differ < 5)
+                {
+                    printf("  %s seed %d budget %d: left %d vs %d points, right %d vs %d points\n", name, s, budgets[b],
+                           stepped.left_edge.raw_points_count, galloped.left_edge.raw_points_count,
+                           stepped.right_edge.raw_points_count, galloped.right_edge.raw_points_count);
+                }
+                differ++;
+            }
+        }
+        // 最后一次为最小上限，这里重新按主流程的上限统计
+        search_line_gallop(&binary_frame, &galloped.left_edge, &galloped.right_edge, budgets[0]);
+        points += galloped.left_edge.raw_points_count + galloped.right_edge.raw_points_count;
+        calls += gallop_stats.trace_calls;
+        hits += gallop_stats.gallop_hits;
+        misses += gallop_stats.gallop_misses;
+
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            search_line_packed(&binary_frame, &stepped.left_edge, &stepped.right_edge, budgets[0]);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            search_line_gallop(&binary_frame, &galloped.left_edge, &galloped.right_edge, budgets[0]);
+        }
+        double t2 = host_seconds();
+        t_step += t1 - t0;
+        t_gallop += t2 - t1;
+    }
+
+    double per_frame = used ? 1e6 / ((double)used * REPEAT) : 0;
+    printf("%-9s %5d frames, differ %d | per frame %.0f points, %.0f trace calls, gallop hits %.1f misses %.1f | "
+           "packed %.2f us, gallop %.2f us\n", name, used, differ, used ? (double)points / used : 0.0,
+           used ? (double)calls / used : 0.0, used ? (double)hits / used : 0.0, used ? (double)misses / used : 0.0,
+           t_step * per_frame, t_gallop * per_frame);
+    return differ;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    int differ = 0;
+
+    differ += check_set("vertical", synth_vertical, frames);
+    differ += check_set("slant", gen_slant, frames);
+    differ += check_set("corner", synth_corner, frames);
+    differ += check_set("curve", synth_curve, frames);
+    differ += check_set("salt", gen_salt, frames);
+
+    if (differ)
+    {
+        printf("FAIL: search_line_gallop differs from search_line_packed\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
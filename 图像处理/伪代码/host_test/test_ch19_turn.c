@@ -0,0 +1,130 @@
+// 第19章 弯心扫描与暴力搜索的一致性测试
+// 对弯道、直角弯、直道三组合成帧运行本章主流程，再对每条提纯后的边缘用浮点暴力搜索重新求弯心：
+// 逐点计算到首尾两点连线的垂直距离 (用点的真实 (x, y) 坐标，不用下标)，取最大者 (相同时取下标较小的点)，
+// 1. turn_center 必须是同一个点，max_deviation 的绝对值为距离向下取整、符号为点在弦的 x 增大一侧为正，
+//    is_turn_found 与“距离 >= TURN_MIN_DEVIATION”一致；
+// 2. 统计弯道标志的帧数，以及 turn_scan 在 extract_and_filter_edges_turn 中增加的耗时。
+// 用法：test_ch19_turn [每组帧数，默认1000]
+#include <stdio.h>
+#include <math.h>
+#include "../image_processing_19.c"
+#include "synth_frames.h"
+
+#define REPEAT 200 // 计时时每帧重复的次数
+
+typedef void (*FrameGenerator)(uint8_t *img, int seed);
+
+static TrackContext context;
+
+// 返回 true 表示与暴力搜索一致
+static bool check_edge(const EdgeTracker *tracker)
+{
+    const int count = tracker->filtered_points_count;
+    const point *edge = tracker->filtered_edge;
+
+    if (count < 3)
+    {
+        return tracker->turn_center.x == 0 && tracker->turn_center.y == 0 && tracker->max_deviation == 0 &&
+               !tracker->is_turn_found;
+    }
+
+    const double x0 = edge[0].x, y0 = edge[0].y;
+    const double dx = edge[count - 1].x - x0, dy = edge[count - 1].y - y0;
+    const double len = sqrt(dx * dx + dy * dy);
+    double best = 0;
+    int best_k = 0;
+    for (int k = 1; k < count - 1; k++)
+    {
+        double d = fabs(dx * (edge[k].y - y0) - dy * (edge[k].x - x0)) / len;
+        if (d > best)
+        {
+            best = d;
+            best_k = k;
+        }
+    }
+
+    // 弦在该点所在行的 x；点在其右侧 (x 更大) 时偏离为正
+    const double chord_x = x0 + dx * (edge[best_k].y - y0) / dy;
+    const int magnitude = (int)floor(best + 1e-9);
+    const int expect = (edge[best_k].x < chord_x) ? -magnitude : magnitude;
+
+    return tracker->turn_center.x == edge[best_k].x && tracker->turn_center.y == edge[best_k].y &&
+           tracker->max_deviation == expect && tracker->is_turn_found == (magnitude >= TURN_MIN_DEVIATION);
+}
+
+// 返回不一致的边数
+static int check_set(const char *name, FrameGenerator gen, int frames)
+{
+    int edges = 0, differ = 0, turns = 0;
+    double t_extract = 0, t_scan = 0;
+
+    memset(&context, 0, sizeof(context));
+    context.left_edge.grow_table = grow_l;
+    context.right_edge.grow_table = grow_r;
+    for (int s = 0; s < frames; s++)
+    {
+        gen(mt9v03x_image_copy[0], s);
+        context.left_edge.filtered_points_count = context.right_edge.filtered_points_count = 0;
+        image_main_process(&context);
+
+        EdgeTracker *trackers[2] = { &context.left_edge, &context.right_edge };
+        for (int e = 0; e < 2; e++)
+        {
+            if (trackers[e]->filtered_points_count == 0)
+            {
+                continue;
+            }
+            edges++;
+            turns += trackers[e]->is_turn_found;
+            if (!check_edge(trackers[e]))
+            {
+                if (differ < 5)
+                {
+                    printf("  %s seed %d %s: center (%d,%d) deviation %d, %d points\n", name, s, e ? "right" : "left",
+                           trackers[e]->turn_center.x, trackers[e]->turn_center.y, trackers[e]->max_deviation,
+                           trackers[e]->filtered_points_count);
+                }
+                differ++;
+            }
+        }
+
+        // 循迹结果不变，只重复提纯；turn_scan 单独计时得到它在提纯中所占的部分
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            extract_and_filter_edges_turn(&context);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            turn_scan(&context.left_edge, context.left_edge.filtered_points_count);
+            turn_scan(&context.right_edge, context.right_edge.filtered_points_count);
+        }
+        double t2 = host_seconds();
+        t_extract += t1 - t0;
+        t_scan += t2 - t1;
+    }
+
+    double per_frame = 1e6 / ((double)frames * REPEAT);
+    printf("%-9s %5d edges, differ %d, turn found %d | extraction %.2f us per frame, turn_scan %.2f us of it (%.0f%%)\n",
+           name, edges, differ, turns, t_extract * per_frame, t_scan * per_frame,
+           t_extract > 0 ? 100.0 * t_scan / t_extract : 0.0);
+    return differ;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 1000;
+    int differ = 0;
+
+    differ += check_set("curve", synth_curve, frames);
+    differ += check_set("corner", synth_corner, frames);
+    differ += check_set("vertical", synth_vertical, frames);
+
+    if (differ)
+    {
+        printf("FAIL: turn_scan differs from the brute-force search\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
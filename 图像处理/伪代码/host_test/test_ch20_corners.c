@@ -0,0 +1,174 @@
+// 第20章 链码拐角检测测试
+// 对 corner_fixtures.h 中的每类合成轮廓跑 binarize_and_pack + search_line_packed + chain_find_corners，
+// 要求每条边界的拐角列表与期望完全一致：个数、顺序、类型相同，位置误差不超过 CORNER_TOLERANCE 像素。
+// 链码最多 MAX_EDGE_POINTS 个点，跟踪器没有走到（或走到后不足半个平滑窗口）的期望拐角不计入；
+// 为了不让提前停下的跟踪器空过比较，每类轮廓另外规定了至少要走到的拐角数和较短一边的最少点数 (min_reached / min_points)。
+// 另外统计每类轮廓上 chain_find_corners (左右两边) 的耗时，与同一帧 search_line_packed 循迹的耗时对照。
+// 用法：test_ch20_corners [每类帧数，默认200]
+#include <stdio.h>
+#include "../image_processing_20.c"
+#include "host_pipeline.h"
+#include "corner_fixtures.h"
+
+#define CORNER_TOLERANCE 3
+#define REPEAT           50 // 计时时每帧重复的次数
+
+typedef void (*FixtureGenerator)(uint8_t *img, int seed, CornerFixture *fx);
+
+static const char *const corner_type_name[] = { "IN", "OUT", "INFL" };
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static TrackContext context;
+
+static void print_corners(const char *side, const ChainCornerList *list)
+{
+    printf("    %s:", side);
+    for (int i = 0; i < list->count; i++)
+    {
+        const ChainCorner *c = &list->corners[i];
+        printf(" %s%+d@(%d,%d)", corner_type_name[c->type], c->turn, c->position.x, c->position.y);
+    }
+    printf("\n");
+}
+
+static void print_expected(const char *side, const ExpectedCorner *list, int count)
+{
+    printf("    expected %s:", side);
+    for (int i = 0; i < count; i++)
+    {
+        printf(" %s@(%d,%d)", corner_type_name[list[i].type], list[i].x, list[i].y);
+    }
+    printf("\n");
+}
+
+// 期望拐角附近有链码点，且其后至少还有 CHAIN_HALF_WINDOW 个点
+static bool corner_reached(const EdgeTracker *tracker, const ExpectedCorner *corner)
+{
+    for (int i = 0; i + CHAIN_HALF_WINDOW <= tracker->raw_points_count; i++)
+    {
+        const point *p = &tracker->raw_edge_points[i];
+        if (abs(p->x - corner->x) <= CORNER_TOLERANCE && abs(p->y - corner->y) <= CORNER_TOLERANCE)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// reached 输出跟踪器走到的期望拐角数
+static bool corners_match(const EdgeTracker *tracker, const ChainCornerList *found, const ExpectedCorner *list, int count,
+                          int *reached)
+{
+    while (count > 0 && !corner_reached(tracker, &list[count - 1]))
+    {
+        count--; // 链码在这些拐角之前就结束了
+    }
+    *reached = count;
+    if (found->count != count)
+    {
+        return false;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        const ChainCorner *c = &found->corners[i];
+        if (c->type != list[i].type ||
+            abs(c->position.x - list[i].x) > CORNER_TOLERANCE ||
+            abs(c->position.y - list[i].y) > CORNER_TOLERANCE)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 返回失败的帧数
+static int run_fixture(FixtureGenerator gen, int frames)
+{
+    CornerFixture fx;
+    int used = 0, failed = 0;
+    double t_trace = 0, t_corners = 0;
+
+    for (int s = 0; s < frames; s++)
+    {
+        point left, right;
+        gen(image, s, &fx);
+        binarize_and_pack(image, 128, &binary_frame);
+        if (!get_start_point_packed(&binary_frame, &left, &right))
+        {
+            printf("  %s seed %d: no start point\n", fx.name, s);
+            failed++;
+            continue;
+        }
+        host_trace_packed(&binary_frame, &context, left, right);
+        chain_find_corners(&context.left_edge, &context.left_corners);
+        chain_find_corners(&context.right_edge, &context.right_corners);
+        used++;
+
+        // 循迹的起点已由 host_trace_packed 写入，重复循迹得到相同的链码
+        double t0 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            search_line_packed(&binary_frame, &context.left_edge, &context.right_edge, MAX_EDGE_POINTS * 2);
+        }
+        double t1 = host_seconds();
+        for (int k = 0; k < REPEAT; k++)
+        {
+            chain_find_corners(&context.left_edge, &context.left_corners);
+            chain_find_corners(&context.right_edge, &context.right_corners);
+        }
+        double t2 = host_seconds();
+        t_trace += t1 - t0;
+        t_corners += t2 - t1;
+
+        int left_reached, right_reached;
+        bool left_ok = corners_match(&context.left_edge, &context.left_corners, fx.left, fx.left_count, &left_reached);
+        bool right_ok = corners_match(&context.right_edge, &context.right_corners, fx.right, fx.right_count, &right_reached);
+        int shortest = (context.left_edge.raw_points_count < context.right_edge.raw_points_count) ?
+                       context.left_edge.raw_points_count : context.right_edge.raw_points_count;
+        bool reached_ok = left_reached + right_reached >= fx.min_reached && shortest >= fx.min_points;
+        if (!reached_ok)
+        {
+            if (failed < 5)
+            {
+                printf("  %s seed %d: trace too short, reached %d expected corners (need %d), %d points (need %d)\n",
+                       fx.name, s, left_reached + right_reached, fx.min_reached, shortest, fx.min_points);
+            }
+            failed++;
+        }
+        else if (!left_ok || !right_ok)
+        {
+            if (failed < 5)
+            {
+                printf("  %s seed %d: corner list mismatch\n", fx.name, s);
+                print_corners("L", &context.left_corners);
+                print_expected("L", fx.left, fx.left_count);
+                print_corners("R", &context.right_corners);
+                print_expected("R", fx.right, fx.right_count);
+            }
+            failed++;
+        }
+    }
+    double per_frame = used ? 1e6 / ((double)used * REPEAT) : 0;
+    printf("%-16s %d frames, %d failed | chain_find_corners %.2f us per frame, search_line_packed %.2f us\n", fx.name, used,
+           failed, t_corners * per_frame, t_trace * per_frame);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 200;
+    int failed = 0;
+
+    failed += run_fixture(fixture_straight, frames * 2);
+    failed += run_fixture(fixture_arc, frames * 2);
+    failed += run_fixture(fixture_crossing, frames);
+    failed += run_fixture(fixture_right_turn, frames);
+    failed += run_fixture(fixture_s_jog, frames);
+
+    if (failed)
+    {
+        printf("FAIL: %d frames with unexpected corner lists\n", failed);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+// 第26章 行流水线测试
+// 1. 同一帧分别按 1/4/8 行一批送入 image_stream_rows，与整帧一次送入 (IMAGE_STREAM_ROWS 为0时的路径) 比较：
+//    阈值、左右行地图、提纯结果和中线偏差必须完全相同。两条路径各用一个 RowStream，大津法阈值各自逐帧传递；
+//    两条路径共用第21章的中线宽度表，它只在单边补线的行上起作用，合成帧两边都能找到，处理顺序不影响偏差。
+// 2. 帧末处理跟不上时 dropped_frames 的计数，以及帧末处理占用的缓冲区不会被下一帧覆盖；
+// 3. 丢行时 row_errors 的计数、整帧作废，以及下一帧恢复。
+// 用法：test_ch26_stream [帧数，默认300]
+#include <stdio.h>
+#include "../image_processing_26.c"
+#include "synth_frames.h"
+
+static const uint8_t chunk_rows[] = { 1, 4, 8 };
+#define CHUNK_KINDS (sizeof(chunk_rows) / sizeof(chunk_rows[0]))
+
+static uint8_t image[SYNTH_H * SYNTH_W];
+static RowStream whole_stream = {.threshold = STREAM_DEFAULT_THRESHOLD, .next_row = STREAM_ROW_INVALID,
+                                 .ready_index = -1, .busy_index = -1};
+static TrackContext whole_ctx, chunk_ctx;
+static int failures;
+
+static void check(bool condition, const char *what)
+{
+    if (!condition)
+    {
+        printf("  FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+// 按 n 行一批送入 [from, to) 行
+static void feed_rows(RowStream *stream, int from, int to, int n)
+{
+    for (int y = from; y < to; y += n)
+    {
+        image_stream_rows(stream, image + y * IMAGE_W, (uint8_t)y, (uint8_t)n);
+    }
+}
+
+static void new_frame(int seed)
+{
+    synth_grey_track(image, seed, 80 + 40 * (seed % 50) / 50); // 亮度在 80%~120% 之间缓慢变化
+}
+
+static bool same_edge(const EdgeTracker *a, const EdgeTracker *b)
+{
+    return a->threshold == b->threshold && a->is_found == b->is_found &&
+           memcmp(a->mapped_edge, b->mapped_edge, IMAGE_H) == 0 &&
+           a->filtered_points_count == b->filtered_points_count &&
+           memcmp(a->filtered_edge, b->filtered_edge, a->filtered_points_count * sizeof(point)) == 0;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 300;
+
+    // --- 1. 分批送入与整帧送入的结果比较 ---
+    int used[CHUNK_KINDS] = { 0 }, map_diff[CHUNK_KINDS] = { 0 }, steer_diff[CHUNK_KINDS] = { 0 }, found = 0;
+    double latency = 0, row_time = 0;
+    for (int f = 0; f < frames; f++)
+    {
+        const int k = f % CHUNK_KINDS;
+        new_frame(f);
+
+        image_stream_rows(&whole_stream, image, 0, IMAGE_H);
+        bool whole_found = image_stream_finish(&whole_stream, &whole_ctx);
+
+        feed_rows(&row_stream, 0, IMAGE_H, chunk_rows[k]);
+        row_time += stream_stats.row_cycles;
+        bool chunk_found = image_stream_finish(&row_stream, &chunk_ctx);
+        latency += stream_stats.latency_cycles;
+
+        used[k]++;
+        found += chunk_found;
+        map_diff[k] += whole_found != chunk_found || !same_edge(&whole_ctx.left_edge, &chunk_ctx.left_edge) ||
+                       !same_edge(&whole_ctx.right_edge, &chunk_ctx.right_edge);
+        steer_diff[k] += whole_ctx.mid_line.is_found != chunk_ctx.mid_line.is_found ||
+                         whole_ctx.mid_line.steering_error != chunk_ctx.mid_line.steering_error;
+    }
+    for (unsigned k = 0; k < CHUNK_KINDS; k++)
+    {
+        printf("%d-row chunks: %3d frames, maps differ %d, steering differs %d\n",
+               chunk_rows[k], used[k], map_diff[k], steer_diff[k]);
+        check(map_diff[k] == 0 && steer_diff[k] == 0, "chunked rows must match the whole-frame path");
+    }
+    printf("track found in %d of %d frames, threshold now %d | latency %.2f us, row hooks %.2f us per frame\n",
+           found, frames, row_stream.threshold, latency / frames / 1000, row_time / frames / 1000);
+    check(found == frames, "every synthetic frame has a track");
+
+    // --- 2. 帧末处理跟不上 ---
+    uint16_t dropped = stream_stats.dropped_frames;
+    for (int f = 0; f < 3; f++)
+    {
+        new_frame(1000 + f);
+        feed_rows(&row_stream, 0, IMAGE_H, 4);
+    }
+    printf("three frames without finish: dropped_frames +%d\n", stream_stats.dropped_frames - dropped);
+    check(stream_stats.dropped_frames - dropped == 2, "two of three unprocessed frames are counted as dropped");
+    check(image_stream_finish(&row_stream, &chunk_ctx), "the newest frame is still processed");
+    check(!image_stream_finish(&row_stream, &chunk_ctx), "no frame is left after it");
+
+    // 帧末处理占用一组缓冲区时 (与 image_stream_finish 开头的认领相同)，期间到达的两帧都必须写入另一组，
+    // 第二帧覆盖第一帧并计入 dropped_frames
+    static BinaryFrame claimed;
+    new_frame(1010);
+    feed_rows(&row_stream, 0, IMAGE_H, 8);
+    const int8_t busy = row_stream.ready_index;
+    row_stream.busy_index = busy;
+    row_stream.ready_index = -1;
+    claimed = row_stream.buffer[busy].bin;
+    dropped = stream_stats.dropped_frames;
+    for (int f = 0; f < 2; f++)
+    {
+        new_frame(1011 + f);
+        feed_rows(&row_stream, 0, IMAGE_H, 8);
+    }
+    printf("two frames arriving during finish: busy %d, newest frame in %d, dropped_frames +%d\n",
+           busy, row_stream.ready_index, stream_stats.dropped_frames - dropped);
+    check(row_stream.ready_index == (busy ^ 1), "frames arriving during finish go to the other buffer");
+    check(stream_stats.dropped_frames - dropped == 1, "the first of them is counted as dropped");
+    check(memcmp(&claimed, &row_stream.buffer[busy].bin, sizeof(claimed)) == 0, "the claimed buffer is not overwritten");
+    row_stream.busy_index = -1;
+    check(image_stream_finish(&row_stream, &chunk_ctx), "the frame that arrived during finish is processed");
+
+    // --- 3. 丢行 ---
+    uint16_t row_errors = stream_stats.row_errors;
+    new_frame(1020);
+    feed_rows(&row_stream, 0, 40, 4);
+    feed_rows(&row_stream, 44, IMAGE_H, 4); // 第 40~43 行丢失
+    printf("rows 40-43 missing: row_errors +%d, ready %d\n", stream_stats.row_errors - row_errors, row_stream.ready_index);
+    check(stream_stats.row_errors - row_errors == 1, "a gap is counted once");
+    check(!image_stream_finish(&row_stream, &chunk_ctx), "the broken frame is discarded");
+    feed_rows(&row_stream, 0, IMAGE_H, 4);
+    check(image_stream_finish(&row_stream, &chunk_ctx), "the next complete frame recovers");
+
+    if (failures)
+    {
+        printf("FAIL: %d checks failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
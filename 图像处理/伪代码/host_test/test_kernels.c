@@ -0,0 +1,209 @@
+// 行扫描内核的单元测试：纯C路径与 DSP 路径都与逐像素的参考实现比较
+// image_kernels.c 编译两次：kernels.o 为主机默认的纯C路径；kernels_dsp.o 定义 __ARM_FEATURE_DSP，
+// 由 dsp_host/cmsis_compiler.h 按架构手册逐字节模拟 __USUB8 / __SEL / __USAD8，函数名加 dsp_ 前缀 (见 Makefile)。
+// 1. img_cmp4_gt / img_cmp4_eq：每个字节位置上所有 (像素, 阈值) 组合，另加随机字；
+// 2. img_row_gt_mask / img_row_eq_mask / img_row_histogram：随机行，长度取 4..192 中所有4的倍数，
+//    检查末字多余的位为0、不写出 IMG_MASK_WORDS(len) 个字之外的内存、直方图在原有计数上累加；
+// 3. img_mask_find_transition：随机掩码上的随机 [from, to] 区间，以及空区间；
+// 4. img_load4 的字节顺序。
+// 用法：test_kernels [随机用例数，默认200000]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "image_kernels.h"
+
+#define MAX_LEN    192
+#define GUARD_WORD 0xA5A5A5A5u // 掩码数组末尾的哨兵，被改写说明越界写入
+
+uint32_t dsp_img_cmp4_gt(uint32_t pixels, uint8_t threshold);                                          // 实现见 image_kernels.c (DSP 路径)
+uint32_t dsp_img_cmp4_eq(uint32_t pixels, uint8_t value);                                              // 实现见 image_kernels.c (DSP 路径)
+void     dsp_img_row_gt_mask(const uint8_t *row, uint16_t len, uint8_t threshold, uint32_t *mask);     // 实现见 image_kernels.c (DSP 路径)
+void     dsp_img_row_eq_mask(const uint8_t *row, uint16_t len, uint8_t value, uint32_t *mask);         // 实现见 image_kernels.c (DSP 路径)
+int16_t  dsp_img_mask_find_transition(const uint32_t *a, const uint32_t *b, int16_t from, int16_t to); // 实现见 image_kernels.c (DSP 路径)
+uint32_t dsp_img_row_histogram(const uint8_t *row, uint16_t len, uint16_t *hist);                      // 实现见 image_kernels.c (DSP 路径)
+
+typedef struct {
+    const char *name;
+    uint32_t (*cmp4_gt)(uint32_t, uint8_t);
+    uint32_t (*cmp4_eq)(uint32_t, uint8_t);
+    void     (*row_gt_mask)(const uint8_t *, uint16_t, uint8_t, uint32_t *);
+    void     (*row_eq_mask)(const uint8_t *, uint16_t, uint8_t, uint32_t *);
+    int16_t  (*find_transition)(const uint32_t *, const uint32_t *, int16_t, int16_t);
+    uint32_t (*row_histogram)(const uint8_t *, uint16_t, uint16_t *);
+} KernelSet;
+
+static const KernelSet kernel_sets[] = {
+    { "C",   img_cmp4_gt, img_cmp4_eq, img_row_gt_mask, img_row_eq_mask, img_mask_find_transition, img_row_histogram },
+    { "DSP", dsp_img_cmp4_gt, dsp_img_cmp4_eq, dsp_img_row_gt_mask, dsp_img_row_eq_mask, dsp_img_mask_find_transition,
+             dsp_img_row_histogram },
+};
+
+static uint32_t random_word(void)
+{
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+// 像素取值集中在阈值附近和 0/255，比均匀随机更容易碰到边界
+static uint8_t random_pixel(uint8_t threshold)
+{
+    switch (rand() % 4)
+    {
+    case 0:  return (uint8_t)(threshold + rand() % 3 - 1);
+    case 1:  return (rand() & 1) ? 255 : 0;
+    default: return (uint8_t)rand();
+    }
+}
+
+static uint32_t ref_cmp4(uint32_t pixels, uint8_t t, bool equal)
+{
+    uint32_t m = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        uint8_t p = (uint8_t)(pixels >> (8 * i));
+        m |= (uint32_t)(equal ? p == t : p > t) << i;
+    }
+    return m;
+}
+
+static bool ref_bit(const uint32_t *mask, int x)
+{
+    return (mask[x >> 5] >> (x & 31)) & 1u;
+}
+
+static int16_t ref_find_transition(const uint32_t *a, const uint32_t *b, int16_t from, int16_t to)
+{
+    for (int x = from; x <= to; x++)
+    {
+        if (ref_bit(a, x) && ref_bit(a, x + 1) && ref_bit(b, x + 2) && ref_bit(b, x + 3))
+        {
+            return (int16_t)x;
+        }
+    }
+    return -1;
+}
+
+// 返回出错的用例数
+static long check_cmp4(const KernelSet *k, int randoms)
+{
+    long wrong = 0;
+    for (int lane = 0; lane < 4; lane++)
+    {
+        for (int v = 0; v < 256; v++)
+        {
+            for (int t = 0; t < 256; t++)
+            {
+                uint32_t w = (random_word() & ~(0xFFu << (8 * lane))) | ((uint32_t)v << (8 * lane));
+                wrong += k->cmp4_gt(w, (uint8_t)t) != ref_cmp4(w, (uint8_t)t, false);
+                wrong += k->cmp4_eq(w, (uint8_t)t) != ref_cmp4(w, (uint8_t)t, true);
+            }
+        }
+    }
+    for (int i = 0; i < randoms; i++)
+    {
+        uint32_t w = random_word();
+        uint8_t t = (uint8_t)rand();
+        wrong += k->cmp4_gt(w, t) != ref_cmp4(w, t, false);
+        wrong += k->cmp4_eq(w, t) != ref_cmp4(w, t, true);
+    }
+    return wrong;
+}
+
+// 返回出错的行数
+static long check_rows(const KernelSet *k, int rows)
+{
+    static uint8_t row[MAX_LEN];
+    long wrong = 0;
+    for (int i = 0; i < rows; i++)
+    {
+        uint16_t len = (uint16_t)(4 + 4 * (i % (MAX_LEN / 4)));
+        uint8_t t = (uint8_t)rand();
+        for (int x = 0; x < len; x++)
+        {
+            row[x] = random_pixel(t);
+        }
+
+        bool bad = false;
+        for (int equal = 0; equal < 2; equal++)
+        {
+            uint32_t mask[IMG_MASK_WORDS(MAX_LEN) + 1];
+            for (int j = 0; j <= IMG_MASK_WORDS(MAX_LEN); j++)
+            {
+                mask[j] = GUARD_WORD;
+            }
+            (equal ? k->row_eq_mask : k->row_gt_mask)(row, len, t, mask);
+
+            bad |= mask[IMG_MASK_WORDS(len)] != GUARD_WORD;
+            for (int x = 0; x < IMG_MASK_WORDS(len) * 32; x++)
+            {
+                bool expect = x < len && (equal ? row[x] == t : row[x] > t);
+                bad |= ref_bit(mask, x) != expect;
+            }
+        }
+
+        uint16_t hist[256], ref_hist[256];
+        uint32_t ref_sum = 0;
+        for (int j = 0; j < 256; j++)
+        {
+            hist[j] = ref_hist[j] = (uint16_t)(rand() % 100); // 在原有计数上累加
+        }
+        for (int x = 0; x < len; x++)
+        {
+            ref_hist[row[x]]++;
+            ref_sum += row[x];
+        }
+        bad |= k->row_histogram(row, len, hist) != ref_sum || memcmp(hist, ref_hist, sizeof(hist)) != 0;
+        wrong += bad;
+    }
+    return wrong;
+}
+
+static long check_transition(const KernelSet *k, int masks)
+{
+    long wrong = 0;
+    for (int i = 0; i < masks; i++)
+    {
+        uint32_t a[IMG_MASK_WORDS(MAX_LEN)], b[IMG_MASK_WORDS(MAX_LEN)];
+        for (int j = 0; j < IMG_MASK_WORDS(MAX_LEN); j++)
+        {
+            // 黑白成段出现：随机字按位或/与几次，得到稀疏和稠密两种
+            a[j] = random_word() | (i & 1 ? random_word() : 0);
+            b[j] = i & 2 ? ~a[j] : random_word() & random_word();
+        }
+        // 掩码必须覆盖到 to + 3
+        int16_t from = (int16_t)(rand() % (MAX_LEN - 3));
+        int16_t to = (int16_t)(from + rand() % (MAX_LEN - 3 - from));
+        wrong += k->find_transition(a, b, from, to) != ref_find_transition(a, b, from, to);
+        wrong += k->find_transition(a, b, to + 1, to) != -1; // 空区间
+    }
+    return wrong;
+}
+
+int main(int argc, char **argv)
+{
+    int randoms = argc > 1 ? atoi(argv[1]) : 200000;
+    bool ok = true;
+
+    static const uint8_t bytes[4] = { 0x11, 0x22, 0x33, 0x44 };
+    bool load_ok = img_load4(bytes) == 0x44332211u;
+    printf("img_load4 byte order: %s\n", load_ok ? "ok" : "wrong");
+    ok &= load_ok;
+
+    for (unsigned s = 0; s < sizeof(kernel_sets) / sizeof(kernel_sets[0]); s++)
+    {
+        const KernelSet *k = &kernel_sets[s];
+        srand(1);
+        long cmp4 = check_cmp4(k, randoms);
+        long rows = check_rows(k, randoms / 10);
+        long transition = check_transition(k, randoms);
+        printf("%-3s path: wrong cmp4 %ld of %d, rows %ld of %d, transition %ld of %d\n", k->name,
+               cmp4, 2 * (4 * 256 * 256 + randoms), rows, randoms / 10, transition, 2 * randoms);
+        ok &= cmp4 == 0 && rows == 0 && transition == 0;
+    }
+
+    if (!ok)
+    {
+        printf("FAIL: a row kernel differs from the per-pixel reference\n");
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
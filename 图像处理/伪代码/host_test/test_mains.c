@@ -0,0 +1,103 @@
+// 各章节主流程的端到端测试
+// 每个章节的 image_main_process 编译时改名为 image_main_process_NN，这里把同一组合成帧写入 mt9v03x_image_copy，
+// 逐章节调用主流程，分别统计左边界提纯成功、右边界提纯成功以及左右都成功的帧数。
+// 各章节的 TrackContext 都以同样的左右 EdgeTracker、贝塞尔曲线结果和 final_distance 开头，后面才是章节自己的成员，
+// 这里只读取开头的公共部分，上下文放在足够大的缓冲区里，章节自己的成员在帧之间保留 (例如上一帧的起点和走廊)。
+// 用法：test_mains [帧数，默认200]
+#include <stdio.h>
+#include "../image_processing_04.c"
+#include "synth_frames.h"
+
+#define BOTH_FOUND_PERCENT 90 // 左右都提纯成功的帧数下限
+
+typedef void (*MainProcess)(TrackContext *context);
+
+void image_main_process_05(TrackContext *context);
+void image_main_process_06(TrackContext *context);
+void image_main_process_07(TrackContext *context);
+void image_main_process_08(TrackContext *context);
+void image_main_process_09(TrackContext *context);
+void image_main_process_10(TrackContext *context);
+void image_main_process_11(TrackContext *context);
+void image_main_process_12(TrackContext *context);
+void image_main_process_13(TrackContext *context);
+void image_main_process_14(TrackContext *context);
+void image_main_process_15(TrackContext *context);
+void image_main_process_16(TrackContext *context);
+void image_main_process_17(TrackContext *context);
+void image_main_process_18(TrackContext *context);
+void image_main_process_19(TrackContext *context);
+void image_main_process_20(TrackContext *context);
+void image_main_process_21(TrackContext *context);
+void image_main_process_22(TrackContext *context);
+void image_main_process_23(TrackContext *context);
+void image_main_process_24(TrackContext *context);
+void image_main_process_25(TrackContext *context);
+
+static const struct {
+    const char *name;
+    MainProcess process;
+} chapters[] = {
+    { "05 packed",        image_main_process_05 },
+    { "06 otsu",          image_main_process_06 },
+    { "07 adaptive",      image_main_process_07 },
+    { "08 seeded",        image_main_process_08 },
+    { "09 roi",           image_main_process_09 },
+    { "10 q16",           image_main_process_10 },
+    { "11 fused row map", image_main_process_11 },
+    { "12 specialized",   image_main_process_12 },
+    { "13 lut",           image_main_process_13 },
+    { "14 gallop",        image_main_process_14 },
+    { "15 runs",          image_main_process_15 },
+    { "16 ccl",           image_main_process_16 },
+    { "17 morph",         image_main_process_17 },
+    { "18 ipm",           image_main_process_18 },
+    { "19 turn",          image_main_process_19 },
+    { "20 corners",       image_main_process_20 },
+    { "21 midline",       image_main_process_21 },
+    { "22 piecewise",     image_main_process_22 },
+    { "23 uniform",       image_main_process_23 },
+    { "24 subpixel",      image_main_process_24 },
+    { "25 pyramid",       image_main_process_25 },
+};
+
+static union {
+    TrackContext context;
+    uint8_t      storage[4096]; // 容纳各章节扩展后的 TrackContext
+} slot;
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 200;
+    int failed = 0;
+
+    for (unsigned c = 0; c < sizeof(chapters) / sizeof(chapters[0]); c++)
+    {
+        TrackContext *context = &slot.context;
+        int left = 0, right = 0, both = 0;
+
+        memset(&slot, 0, sizeof(slot));
+        context->left_edge.grow_table = grow_l;
+        context->right_edge.grow_table = grow_r;
+        for (int s = 0; s < frames; s++)
+        {
+            synth_curve(mt9v03x_image_copy[0], s);
+            context->left_edge.is_found = context->right_edge.is_found = false; // 找不到起点时主流程直接返回
+            chapters[c].process(context);
+            left += context->left_edge.is_found;
+            right += context->right_edge.is_found;
+            both += context->left_edge.is_found && context->right_edge.is_found;
+        }
+        bool ok = both * 100 >= frames * BOTH_FOUND_PERCENT;
+        printf("%-18s left %3d  right %3d  both %3d of %d%s\n", chapters[c].name, left, right, both, frames,
+               ok ? "" : "  <-- too few");
+        failed += !ok;
+    }
+
+    if (failed)
+    {
+        printf("FAIL: %d chapters lose an edge in their main process\n", failed);
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
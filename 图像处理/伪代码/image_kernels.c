@@ -0,0 +1,208 @@
+#include "image_kernels.h"
+#include <string.h> // 为 memcpy 添加头文件
+
+#if IMAGE_KERNELS_USE_DSP
+#include "cmsis_compiler.h" // __USUB8 / __SEL / __USAD8 / __RBIT / __CLZ
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      计算32位整数末尾0的个数
+// 备注信息      调用者保证 v 不为0；M4 上为 RBIT + CLZ 两条指令。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint8_t img_ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#elif IMAGE_KERNELS_USE_DSP
+    return (uint8_t)__CLZ(__RBIT(v));
+#else
+    uint8_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把分散在每个字节最高位 (bit 7/15/23/31) 的标志收拢为4位掩码
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t img_gather_msb(uint32_t t)
+{
+    return (((t & 0x80808080u) >> 7) * 0x01020408u) >> 24;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      读取4个连续像素，拼成32位字
+// 备注信息      小端序平台上 memcpy 会被优化为单条 LDR (M4 支持非对齐访问)；大端序平台逐字节拼接。
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t img_load4(const uint8_t *p)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+#else
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      4个像素与阈值比较
+// 参数说明      pixels        img_load4 读取的4个像素
+// 参数说明      threshold     阈值
+// 返回参数      uint32_t      4位掩码，第 i 位为1表示第 i 个像素 > threshold
+// 备注信息      DSP：__USUB8(pixels, threshold + 1) 按字节做减法并把“未借位 (>=)”写入 APSR.GE[3:0]，
+//               __SEL 按 GE 标志从 0x08040201 中挑出各字节的权值，最后一次乘法把4个字节加到最高字节。
+// 备注信息      纯C：x > t ⇔ x + (255 - t) 产生进位。先对低7位做不会跨字节进位的加法，
+//               再用全加器公式求出每个字节最高位的进位，结果与 DSP 版本完全一致。
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t img_cmp4_gt(uint32_t pixels, uint8_t threshold)
+{
+#if IMAGE_KERNELS_USE_DSP
+    if (threshold == 255)
+    {
+        return 0; // 没有像素能大于255，且 threshold + 1 会溢出
+    }
+    __USUB8(pixels, (uint32_t)(threshold + 1) * 0x01010101u);
+    return (__SEL(0x08040201u, 0) * 0x01010101u) >> 24;
+#else
+    uint32_t c_rep = (uint32_t)(255 - threshold) * 0x01010101u;
+    uint32_t s = (pixels & 0x7F7F7F7Fu) + (c_rep & 0x7F7F7F7Fu);            // 低7位之和，bit7 为进位输入
+    uint32_t carry = (pixels & c_rep) | (s & (pixels ^ c_rep));            // 每个字节最高位的进位输出
+    return img_gather_msb(carry);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      4个像素与给定灰度值比较
+// 返回参数      uint32_t      4位掩码，第 i 位为1表示第 i 个像素 == value
+// 备注信息      DSP：x == v ⇔ x >= v 且 v >= x，两次 __USUB8 + __SEL 即可得到相等字节。
+// 备注信息      纯C：异或后找全0字节，((w & 0x7F..) + 0x7F..) | w 使所有非0字节的最高位置1，且不会跨字节进位。
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t img_cmp4_eq(uint32_t pixels, uint8_t value)
+{
+    uint32_t v_rep = (uint32_t)value * 0x01010101u;
+#if IMAGE_KERNELS_USE_DSP
+    __USUB8(pixels, v_rep);
+    uint32_t ge = __SEL(0x08040201u, 0); // pixels >= value
+    __USUB8(v_rep, pixels);
+    uint32_t eq = __SEL(ge, 0);          // 且 value >= pixels
+    return (eq * 0x01010101u) >> 24;
+#else
+    uint32_t w = pixels ^ v_rep;
+    uint32_t t = ((w & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | w; // 非0字节 → 最高位为1
+    return img_gather_msb(~t);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      整行二值化为位掩码 (像素 > threshold 记为1)
+// 参数说明      row           行首地址
+// 参数说明      len           像素个数，4的倍数
+// 参数说明      threshold     阈值
+// 参数说明      mask          输出位掩码，共 IMG_MASK_WORDS(len) 个字
+// 备注信息      每4个像素得到4位，8组拼满一个字后写出，末字多余的位保持为0。
+//-------------------------------------------------------------------------------------------------------------------
+void img_row_gt_mask(const uint8_t *row, uint16_t len, uint8_t threshold, uint32_t *mask)
+{
+    uint32_t word = 0;
+    for (uint16_t x = 0; x < len; x += 4)
+    {
+        word |= img_cmp4_gt(img_load4(row + x), threshold) << (x & 31);
+        if ((x & 31) == 28 || x + 4 >= len)
+        {
+            mask[x >> 5] = word;
+            word = 0;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      整行按“等于 value”生成位掩码
+// 备注信息      参数与输出格式同 img_row_gt_mask。
+//-------------------------------------------------------------------------------------------------------------------
+void img_row_eq_mask(const uint8_t *row, uint16_t len, uint8_t value, uint32_t *mask)
+{
+    uint32_t word = 0;
+    for (uint16_t x = 0; x < len; x += 4)
+    {
+        word |= img_cmp4_eq(img_load4(row + x), value) << (x & 31);
+        if ((x & 31) == 28 || x + 4 >= len)
+        {
+            mask[x >> 5] = word;
+            word = 0;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在行位掩码中查找第一个“a,a,b,b”跳变
+// 参数说明      a / b         跳变前、后像素的位掩码 (黑/白 或 白/黑)
+// 参数说明      from / to     搜索区间 [from, to]，掩码至少覆盖到第 to + 3 位
+// 返回参数      int16_t       第一个满足条件的 x，找不到返回 -1
+// 备注信息      每次处理32个候选位置：把 a、a>>1、b>>2、b>>3 (跨字时拼接下一个字) 相与，命中位即为跳变起点。
+//-------------------------------------------------------------------------------------------------------------------
+int16_t img_mask_find_transition(const uint32_t *a, const uint32_t *b, int16_t from, int16_t to)
+{
+    if (from > to)
+    {
+        return -1;
+    }
+
+    const int16_t words = ((to + 3) >> 5) + 1; // 掩码中会被读取的字数
+    for (int16_t i = from >> 5; i <= (to >> 5); i++)
+    {
+        uint32_t a_next = (i + 1 < words) ? a[i + 1] : 0;
+        uint32_t b_next = (i + 1 < words) ? b[i + 1] : 0;
+
+        // 第x位为1 ⇔ a[x] && a[x+1] && b[x+2] && b[x+3]
+        uint32_t match = a[i] & ((a[i] >> 1) | (a_next << 31))
+                              & ((b[i] >> 2) | (b_next << 30))
+                              & ((b[i] >> 3) | (b_next << 29));
+
+        // 限制到 [from, to]
+        int16_t base = i * 32;
+        if (base < from)
+        {
+            match &= ~0u << (from - base);
+        }
+        if (to - base < 31)
+        {
+            match &= (1u << (to - base + 1)) - 1u;
+        }
+
+        if (match)
+        {
+            return (int16_t)(base + img_ctz32(match));
+        }
+    }
+    return -1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      将一行像素累加到直方图
+// 参数说明      row           行首地址
+// 参数说明      len           像素个数，4的倍数
+// 参数说明      hist          256 项直方图，在原有计数上累加
+// 返回参数      uint32_t      本行的灰度总和
+// 备注信息      每次读取一个字拆出4个像素计数；灰度和在 DSP 上用 __USAD8(w, 0) 一条指令求出4个字节之和，
+//               纯C版本先把4个字节两两相加成两个16位通道，再合并。
+//-------------------------------------------------------------------------------------------------------------------
+uint32_t img_row_histogram(const uint8_t *row, uint16_t len, uint16_t *hist)
+{
+    uint32_t sum = 0;
+    for (uint16_t x = 0; x < len; x += 4)
+    {
+        uint32_t w = img_load4(row + x);
+        hist[w & 0xFF]++;
+        hist[(w >> 8) & 0xFF]++;
+        hist[(w >> 16) & 0xFF]++;
+        hist[w >> 24]++;
+#if IMAGE_KERNELS_USE_DSP
+        sum += __USAD8(w, 0);
+#else
+        uint32_t pair = (w & 0x00FF00FFu) + ((w >> 8) & 0x00FF00FFu); // 两个16位通道
+        sum += (pair & 0xFFFFu) + (pair >> 16);
+#endif
+    }
+    return sum;
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef __IMAGE_KERNELS_H__
+#define __IMAGE_KERNELS_H__
+
+#include "stdint.h"
+#include <stdbool.h>
+
+//=============================================================================
+// 图像行扫描内核
+// 说明:
+// 1. Cortex-M4/M7 (编译器定义 __ARM_FEATURE_DSP) 上使用 __USUB8 / __SEL / __USAD8 等 SIMD 指令，
+//    一条指令同时处理4个像素；其他平台 (包括 Linux 主机) 使用结果完全相同的纯C实现，便于在电脑上调试验证。
+// 2. 定义 IMAGE_KERNELS_FORCE_C 可以在 M4 上强制使用纯C实现，用于对比两种实现的结果和耗时。
+// 3. 像素按行存储，行长度 len 必须是4的倍数 (IMAGE_W = 188 满足)。
+// 4. 位掩码格式与压缩二值图 BinaryFrame 相同：第 x 个像素对应 mask[x >> 5] 的第 (x & 31) 位。
+//=============================================================================
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1) && !defined(IMAGE_KERNELS_FORCE_C)
+#define IMAGE_KERNELS_USE_DSP 1
+#else
+#define IMAGE_KERNELS_USE_DSP 0
+#endif
+
+// 长度为 len 的行位掩码需要的32位字数
+#define IMG_MASK_WORDS(len) (((len) + 31) / 32)
+
+/**
+ * @brief 读取4个连续像素，拼成32位字
+ * @note  第 i 个像素位于第 i 个字节 (低字节在前)，与平台字节序无关
+ */
+uint32_t img_load4(const uint8_t *p);
+
+/**
+ * @brief 4个像素与阈值比较
+ * @param pixels    img_load4 读取的4个像素
+ * @param threshold 阈值
+ * @return 4位掩码，第 i 位为1表示第 i 个像素 > threshold
+ */
+uint32_t img_cmp4_gt(uint32_t pixels, uint8_t threshold);
+
+/**
+ * @brief 4个像素与给定灰度值比较
+ * @return 4位掩码，第 i 位为1表示第 i 个像素 == value
+ */
+uint32_t img_cmp4_eq(uint32_t pixels, uint8_t value);
+
+/**
+ * @brief 整行二值化为位掩码 (像素 > threshold 记为1)
+ * @param mask 输出，共 IMG_MASK_WORDS(len) 个字，末字多余的位清零
+ */
+void img_row_gt_mask(const uint8_t *row, uint16_t len, uint8_t threshold, uint32_t *mask);
+
+/**
+ * @brief 整行按“等于 value”生成位掩码
+ * @param mask 输出，共 IMG_MASK_WORDS(len) 个字，末字多余的位清零
+ */
+void img_row_eq_mask(const uint8_t *row, uint16_t len, uint8_t value, uint32_t *mask);
+
+/**
+ * @brief 在行位掩码中查找第一个“a,a,b,b”跳变
+ * @param a    跳变前像素的位掩码 (例如黑色)
+ * @param b    跳变后像素的位掩码 (例如白色)
+ * @param from 搜索起点 x (包含)
+ * @param to   搜索终点 x (包含)，掩码至少要覆盖到第 to + 3 位
+ * @return 满足 a[x] && a[x+1] && b[x+2] && b[x+3] 的最小 x，找不到返回 -1
+ */
+int16_t img_mask_find_transition(const uint32_t *a, const uint32_t *b, int16_t from, int16_t to);
+
+/**
+ * @brief 将一行像素累加到直方图
+ * @param hist 256 项直方图，在原有计数上累加 (调用前自行清零)
+ * @return 本行的灰度总和
+ */
+uint32_t img_row_histogram(const uint8_t *row, uint16_t len, uint16_t *hist);
+
+#endif //__IMAGE_KERNELS_H__
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+#include "image_kernels.h" // 行扫描内核 (Cortex-M4 上使用 DSP 指令)
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      带边界检查的像素读取，图像外一律视为黑色
+// 备注信息      坐标为 uint8_t，越过左/上边界时会回绕成很大的值，因此一次无符号比较即可覆盖四个方向。
+//               灰度版循迹依赖黑边框，越界读取的是相邻内存；压缩帧按字存储，越界会读到其他行甚至帧外，必须拦截。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t bin_pixel_checked(const BinaryFrame *frame, uint8_t x, uint8_t y)
+{
+    if (x >= IMAGE_W || y >= IMAGE_H)
+    {
+        return 0;
+    }
+    return BIN_PIXEL(frame, x, y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      将灰度图一次性二值化并压缩为 1bpp 格式
+// 参数说明      image         灰度图像数据指针
+// 参数说明      threshold     二值化阈值，像素值 > threshold 记为白
+// 参数说明      frame         输出的压缩二值图
+// 备注信息      后续的起点搜索和循迹都只读取压缩帧，不再重复访问 22.5KB 的灰度图并逐像素比较阈值。
+// 备注信息      循迹原本以 “< threshold 为黑、> threshold 为白” 判断，起点搜索以 “== 0 / == 255” 判断，
+//               对已经二值化为 0/255 的帧（即起点搜索能正常工作的帧），两者与 “> threshold 为白” 完全一致。
+//-------------------------------------------------------------------------------------------------------------------
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame)
+{
+    frame->threshold = threshold;
+
+    // 每行交给行扫描内核，一次比较4个像素；内核会写满整行的6个字（包括末字的填充位）
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        img_row_gt_mask(image + y * IMAGE_W, IMAGE_W, threshold, frame->row[y]);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在压缩二值图中从下向上搜索赛道左右边界的起始点
+// 参数说明      frame         压缩二值图
+// 参数说明      p_left        用于存储左边界起点坐标的指针 (point *)
+// 参数说明      p_right       用于存储右边界起点坐标的指针 (point *)
+// 返回参数      bool          如果同时找到左右边界则返回true，否则返回false
+// 备注信息      逻辑与 get_start_point 完全相同，但一行只需读取 6 个字，黑色掩码直接由白色掩码取反得到。
+//-------------------------------------------------------------------------------------------------------------------
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right)
+{
+    uint32_t black[BIN_ROW_WORDS];
+    int16_t x;
+
+    for (int y = IMAGE_H - 2; y > 0; y--)
+    {
+        const uint32_t *white = frame->row[y];
+        bool l_found = false;
+        bool r_found = false;
+
+        for (int i = 0; i < BIN_ROW_WORDS; i++)
+        {
+            black[i] = ~white[i];
+        }
+        black[BIN_ROW_WORDS - 1] &= BIN_LAST_WORD_MASK;
+
+        // 紧贴图像边缘的特殊情况
+        if (BIN_PIXEL(frame, 1, y) && BIN_PIXEL(frame, 2, y))
+        {
+            l_found = true;
+            p_left->x = 1;
+            p_left->y = y;
+        }
+        if (BIN_PIXEL(frame, IMAGE_W - 2, y) && BIN_PIXEL(frame, IMAGE_W - 3, y))
+        {
+            r_found = true;
+            p_right->x = IMAGE_W - 2;
+            p_right->y = y;
+        }
+
+        // 搜索区间与 get_start_point 相同：x ∈ [1, IMAGE_W - 4]
+        if (!l_found && (x = img_mask_find_transition(black, white, 1, IMAGE_W - 4)) >= 0)
+        {
+            l_found = true;
+            p_left->x = (uint8_t)x;
+            p_left->y = y;
+        }
+        if (!r_found && (x = img_mask_find_transition(white, black, 1, IMAGE_W - 4)) >= 0)
+        {
+            r_found = true;
+            p_right->x = (uint8_t)x;
+            p_right->y = y;
+        }
+
+        // 宽度校验，与 get_start_point 相同
+        if (l_found && r_found && (p_right->x - p_left->x) > 10)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把起点搜索的结果移到轮廓跟踪的出发点
+// 参数说明      p_left        get_start_point / get_start_point_packed 给出的左起点，原地修改
+// 参数说明      p_right       右起点，原地修改
+// 备注信息      起点搜索记录的是“黑,黑,白,白”“白,白,黑,黑”模式的第一个像素，跟踪器要从紧贴跳变的黑像素出发：
+//               左起点右移1，右起点右移2。直接从模式的第一个像素出发，左边界走两三步就找不到跳变而停止。
+// 备注信息      赛道贴着右侧图像边缘时右起点是 x = IMAGE_W - 2 的白像素，右边就是黑边框，不再移动，否则会移出图像。
+//-------------------------------------------------------------------------------------------------------------------
+void adjust_start_point_for_trace(point *p_left, point *p_right)
+{
+    p_left->x += 1;
+    if (p_right->x != IMAGE_W - 2)
+    {
+        p_right->x += 2;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（压缩二值图版本）
+// 参数说明      frame         压缩二值图
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      搜索顺序与 trace_single_step 完全相同，只是把两次灰度读取和阈值比较换成了两次位读取。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_packed(const BinaryFrame *frame, EdgeTracker *tracker)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        uint8_t a0_x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        uint8_t a0_y = tracker->current_point.y + tracker->grow_table[dir0].y;
+        uint8_t a1_x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        uint8_t a1_y = tracker->current_point.y + tracker->grow_table[dir1].y;
+
+        // 黑 → 白 跳变
+        if (!bin_pixel_checked(frame, a0_x, a0_y) && bin_pixel_checked(frame, a1_x, a1_y))
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point.x += tracker->grow_table[dir1].x;
+            tracker->current_point.y += tracker->grow_table[dir1].y;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（压缩二值图版本）
+// 备注信息      调度策略和终止条件与 search_line 相同。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_packed(frame, left_tracker);
+            } else {
+                trace_single_step_packed(frame, right_tracker);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_packed(frame, left_tracker);
+        } else if (right_tracker->is_active) {
+            trace_single_step_packed(frame, right_tracker);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（压缩二值图版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      先做一次二值化压缩，之后的起点搜索与循迹都只读取 2.8KB 的压缩帧。
+// 备注信息      压缩帧只有一个阈值，这里统一使用左边缘的阈值。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩：整帧只读取一次灰度图 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+#include "image_kernels.h" // 行扫描内核 (Cortex-M4 上使用 DSP 指令)
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+// 周期计数器：在 Cortex-M4 上可定义为 (DWT->CYCCNT)，未定义时各阶段的周期统计恒为0
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u
+#endif
+
+// 直方图按行交错划分为若干条带，条带 k 由满足 y % OTSU_STRIPES == k 的行组成。
+// 每帧只重新统计一个条带，其余条带沿用前几帧的结果，单帧读取的像素数降为 1/OTSU_STRIPES。
+// 设为1则每帧都做全帧统计。
+#define OTSU_STRIPES 4
+#define OTSU_PIXEL_COUNT ((uint32_t)IMAGE_W * IMAGE_H)
+
+// 自动阈值模块的状态，需要跨帧保存
+typedef struct {
+    // --- 直方图数据 ---
+    uint16_t stripe_hist[OTSU_STRIPES][256]; // 各条带的直方图 (每条带最多 30*188 个像素，uint16_t 足够)
+    uint32_t stripe_sum[OTSU_STRIPES];       // 各条带的灰度总和
+    uint32_t hist[256];                      // 全帧直方图 = 各条带直方图之和
+    uint32_t total_sum;                      // 全帧灰度总和
+    uint8_t  next_stripe;                    // 下一帧要刷新的条带
+    bool     is_primed;                      // 是否已完成首次全帧统计
+
+    // --- 结果 ---
+    uint8_t  threshold;                      // 最近一次计算得到的阈值，像素值 > threshold 为白
+
+    // --- 单帧开销统计 ---
+    uint32_t pixels_read;                    // 本帧读取的像素数
+    uint32_t hist_cycles;                    // 本帧直方图更新耗时 (周期)
+    uint32_t otsu_cycles;                    // 本帧大津法求解耗时 (周期)
+} ThresholdState;
+
+static ThresholdState threshold_state; // 自动阈值的跨帧状态
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      重新统计一个条带的直方图，并同步更新全帧直方图
+// 参数说明      state         自动阈值状态
+// 参数说明      image         灰度图像数据指针
+// 参数说明      stripe        要刷新的条带编号
+// 备注信息      先从全帧直方图中减去该条带的旧数据，再用行扫描内核逐行累加条带直方图和灰度总和，
+//               最后把新的条带直方图整体加回全帧直方图（256次加法，代替每个像素两次计数）。
+//-------------------------------------------------------------------------------------------------------------------
+static void refresh_histogram_stripe(ThresholdState *state, const uint8_t *image, uint8_t stripe)
+{
+    uint16_t *stripe_hist = state->stripe_hist[stripe];
+    uint32_t sum = 0;
+
+    // 1. 移除旧数据
+    for (int i = 0; i < 256; i++)
+    {
+        state->hist[i] -= stripe_hist[i];
+    }
+    state->total_sum -= state->stripe_sum[stripe];
+    memset(stripe_hist, 0, sizeof(state->stripe_hist[0]));
+
+    // 2. 单次遍历：直方图与灰度总和同时累加
+    for (int y = stripe; y < IMAGE_H; y += OTSU_STRIPES)
+    {
+        sum += img_row_histogram(image + y * IMAGE_W, IMAGE_W, stripe_hist);
+        state->pixels_read += IMAGE_W;
+    }
+
+    // 3. 加回全帧
+    for (int i = 0; i < 256; i++)
+    {
+        state->hist[i] += stripe_hist[i];
+    }
+    state->stripe_sum[stripe] = sum;
+    state->total_sum += sum;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      用纯整数运算求大津法 (Otsu) 阈值
+// 参数说明      hist          全帧直方图
+// 参数说明      total_sum     全帧灰度总和
+// 返回参数      uint8_t       使类间方差最大的阈值 t，分类为 {<= t} 和 {> t}
+// 备注信息      类间方差 σ² ∝ d² / (w0 * w1)，其中 d = w0 * μT - s0 = (S * w0 - s0 * N) / N，
+//               w0/s0 为 <= t 部分的像素数和灰度和。d 不超过 2^21，d² 左移16位后仍在 uint64_t 范围内，
+//               整个求解不需要浮点运算和开方。
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t otsu_threshold(const uint32_t hist[256], uint32_t total_sum)
+{
+    uint32_t w0 = 0;          // 背景像素数
+    uint32_t s0 = 0;          // 背景灰度和
+    uint64_t best_score = 0;
+    uint8_t  best_t = 128;    // 直方图退化（单一灰度）时保持默认阈值
+
+    for (int t = 0; t < 255; t++)
+    {
+        w0 += hist[t];
+        s0 += (uint32_t)t * hist[t];
+        if (w0 == 0)
+        {
+            continue;
+        }
+        uint32_t w1 = OTSU_PIXEL_COUNT - w0;
+        if (w1 == 0)
+        {
+            break;
+        }
+
+        int64_t d = ((int64_t)total_sum * w0 - (int64_t)s0 * OTSU_PIXEL_COUNT) / (int64_t)OTSU_PIXEL_COUNT;
+        uint64_t score = ((uint64_t)(d * d) << 16) / ((uint64_t)w0 * w1);
+        if (score > best_score)
+        {
+            best_score = score;
+            best_t = (uint8_t)t;
+        }
+    }
+    return best_t;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      自动阈值阶段：更新直方图并求出本帧阈值
+// 参数说明      state         自动阈值状态（跨帧保存）
+// 参数说明      image         灰度图像数据指针
+// 返回参数      uint8_t       本帧使用的阈值
+// 备注信息      首帧统计全部条带；之后每帧只刷新一个条带，其余条带复用前几帧的直方图。
+// 备注信息      本帧的像素读取数和两部分的周期数记录在 state 中，可用于核对是否满足帧时间预算。
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t threshold_update(ThresholdState *state, const uint8_t *image)
+{
+    uint32_t t0 = IMAGE_CYCLE_COUNTER();
+    state->pixels_read = 0;
+
+    if (!state->is_primed)
+    {
+        for (uint8_t k = 0; k < OTSU_STRIPES; k++)
+        {
+            refresh_histogram_stripe(state, image, k);
+        }
+        state->next_stripe = 0;
+        state->is_primed = true;
+    }
+    else
+    {
+        refresh_histogram_stripe(state, image, state->next_stripe);
+        state->next_stripe = (state->next_stripe + 1) % OTSU_STRIPES;
+    }
+
+    uint32_t t1 = IMAGE_CYCLE_COUNTER();
+    state->threshold = otsu_threshold(state->hist, state->total_sum);
+    uint32_t t2 = IMAGE_CYCLE_COUNTER();
+
+    state->hist_cycles = t1 - t0;
+    state->otsu_cycles = t2 - t1;
+    return state->threshold;
+}
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（自动阈值版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      用大津法阈值取代固定的 128，其余流程与压缩二值图版本相同。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段：自动阈值 ---
+    uint8_t threshold = threshold_update(&threshold_state, mt9v03x_image_copy[0]);
+    context->left_edge.threshold = threshold;
+    context->right_edge.threshold = threshold;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,427 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+// 局部自适应阈值参数
+#define ADAPTIVE_RADIUS  5   // 局部窗口半径，窗口大小为 (2R+1) x (2R+1)
+#define ADAPTIVE_OFFSET  8   // 局部阈值 = 局部均值 - ADAPTIVE_OFFSET
+
+// 积分图（前缀和表）使用 uint16_t 存储，依靠无符号回绕做模 65536 运算：
+// 只要窗口内的真实像素和 < 65536，四项加减之后的结果就是精确的。
+// 15x15 窗口最大和为 225*255 = 57375，因此半径最大为 7。整张表为 121*189*2 ≈ 45KB，是 uint32_t 版本的一半。
+#if ((2 * ADAPTIVE_RADIUS + 1) * (2 * ADAPTIVE_RADIUS + 1) * 255) > 65535
+#error "ADAPTIVE_RADIUS 过大，uint16_t 积分图无法精确表示窗口像素和"
+#endif
+
+typedef struct {
+    uint16_t sum[IMAGE_H + 1][IMAGE_W + 1]; // sum[y][x] = 左上角 [0,y) x [0,x) 区域的像素和 (模 65536)
+    uint32_t queries;                       // 本帧局部阈值查询次数
+} IntegralImage;
+
+static IntegralImage integral_image; // 本帧的积分图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      构建积分图
+// 参数说明      image         灰度图像数据指针
+// 参数说明      sat           输出的积分图
+// 备注信息      每个像素只读取一次：行内累加得到行前缀和，再加上上一行同列的积分值。
+//-------------------------------------------------------------------------------------------------------------------
+void integral_image_build(const uint8_t *image, IntegralImage *sat)
+{
+    memset(sat->sum[0], 0, sizeof(sat->sum[0]));
+    sat->queries = 0;
+
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        const uint8_t *row_ptr = image + y * IMAGE_W;
+        const uint16_t *above = sat->sum[y];
+        uint16_t *out = sat->sum[y + 1];
+        uint16_t row_sum = 0;
+
+        out[0] = 0;
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            row_sum += row_ptr[x];
+            out[x + 1] = (uint16_t)(above[x + 1] + row_sum);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      O(1) 查询某个像素的局部阈值
+// 参数说明      sat           积分图
+// 参数说明      x / y         像素坐标
+// 返回参数      uint8_t       局部均值减去 ADAPTIVE_OFFSET，下限为0
+// 备注信息      窗口在图像边缘处自动裁剪，均值按实际像素数计算。
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t adaptive_local_threshold(IntegralImage *sat, uint8_t x, uint8_t y)
+{
+    int x0 = x - ADAPTIVE_RADIUS;
+    int y0 = y - ADAPTIVE_RADIUS;
+    int x1 = x + ADAPTIVE_RADIUS + 1; // 开区间
+    int y1 = y + ADAPTIVE_RADIUS + 1;
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > IMAGE_W) x1 = IMAGE_W;
+    if (y1 > IMAGE_H) y1 = IMAGE_H;
+
+    sat->queries++;
+
+    uint16_t box = (uint16_t)(sat->sum[y1][x1] - sat->sum[y0][x1] - sat->sum[y1][x0] + sat->sum[y0][x0]);
+    int mean = box / ((x1 - x0) * (y1 - y0));
+    return (mean > ADAPTIVE_OFFSET) ? (uint8_t)(mean - ADAPTIVE_OFFSET) : 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      判断像素在自适应阈值下是否为白色
+// 备注信息      越界坐标视为黑色（与压缩帧版本的约定一致），像素值 > 局部阈值为白。
+//-------------------------------------------------------------------------------------------------------------------
+static inline bool adaptive_is_white(const uint8_t *image, IntegralImage *sat, uint8_t x, uint8_t y)
+{
+    if (x >= IMAGE_W || y >= IMAGE_H)
+    {
+        return false;
+    }
+    return image[y * IMAGE_W + x] > adaptive_local_threshold(sat, x, y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      全帧自适应二值化并压缩为 1bpp 格式
+// 参数说明      image         灰度图像数据指针
+// 参数说明      sat           已构建好的积分图
+// 参数说明      frame         输出的压缩二值图
+// 备注信息      对每个像素查询一次局部阈值，作为逐点查询模式的对照，输出可直接交给 get_start_point_packed / search_line_packed。
+//-------------------------------------------------------------------------------------------------------------------
+void adaptive_binarize_and_pack(const uint8_t *image, IntegralImage *sat, BinaryFrame *frame)
+{
+    memset(frame->row, 0, sizeof(frame->row));
+    frame->threshold = 0; // 无全局阈值
+
+    for (uint8_t y = 0; y < IMAGE_H; y++)
+    {
+        for (uint8_t x = 0; x < IMAGE_W; x++)
+        {
+            if (adaptive_is_white(image, sat, x, y))
+            {
+                frame->row[y][x >> 5] |= 1u << (x & 31);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在自适应阈值下搜索起始点（逐点查询模式）
+// 参数说明      image         灰度图像数据指针
+// 参数说明      sat           已构建好的积分图
+// 参数说明      p_left        用于存储左边界起点坐标的指针 (point *)
+// 参数说明      p_right       用于存储右边界起点坐标的指针 (point *)
+// 返回参数      bool          如果同时找到左右边界则返回true，否则返回false
+// 备注信息      逻辑与 get_start_point 相同，但只对实际扫描到的行做分类，找到起始行后立即返回。
+//-------------------------------------------------------------------------------------------------------------------
+bool get_start_point_adaptive(const uint8_t *image, IntegralImage *sat, point *p_left, point *p_right)
+{
+    bool white[IMAGE_W];
+
+    for (int y = IMAGE_H - 2; y > 0; y--)
+    {
+        bool l_found = false;
+        bool r_found = false;
+
+        for (int x = 0; x < IMAGE_W; x++)
+        {
+            white[x] = adaptive_is_white(image, sat, (uint8_t)x, (uint8_t)y);
+        }
+
+        if (white[1] && white[2])
+        {
+            l_found = true;
+            p_left->x = 1;
+            p_left->y = y;
+        }
+        if (white[IMAGE_W - 2] && white[IMAGE_W - 3])
+        {
+            r_found = true;
+            p_right->x = IMAGE_W - 2;
+            p_right->y = y;
+        }
+
+        for (int x = 1; x < (IMAGE_W - 3) && !(l_found && r_found); x++)
+        {
+            if (!l_found && !white[x] && !white[x + 1] && white[x + 2] && white[x + 3])
+            {
+                l_found = true;
+                p_left->x = x;
+                p_left->y = y;
+            }
+            if (!r_found && white[x] && white[x + 1] && !white[x + 2] && !white[x + 3])
+            {
+                r_found = true;
+                p_right->x = x;
+                p_right->y = y;
+            }
+        }
+
+        if (l_found && r_found && (p_right->x - p_left->x) > 10)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（自适应阈值，逐点查询模式）
+// 参数说明      image         灰度图像数据指针
+// 参数说明      sat           已构建好的积分图
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      与 trace_single_step 的搜索顺序相同，只在实际探测的两个像素上查询局部阈值，
+//               不需要对整帧做自适应二值化。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_adaptive(const uint8_t *image, IntegralImage *sat, EdgeTracker *tracker)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        uint8_t a0_x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        uint8_t a0_y = tracker->current_point.y + tracker->grow_table[dir0].y;
+        uint8_t a1_x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        uint8_t a1_y = tracker->current_point.y + tracker->grow_table[dir1].y;
+
+        // 黑 → 白 跳变，a0 不是黑色时无需再查询 a1
+        if (!adaptive_is_white(image, sat, a0_x, a0_y) && adaptive_is_white(image, sat, a1_x, a1_y))
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point.x += tracker->grow_table[dir1].x;
+            tracker->current_point.y += tracker->grow_table[dir1].y;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（自适应阈值，逐点查询模式）
+// 备注信息      调度策略和终止条件与 search_line 相同。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_adaptive(const uint8_t *image, IntegralImage *sat, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_adaptive(image, sat, left_tracker);
+            } else {
+                trace_single_step_adaptive(image, sat, right_tracker);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_adaptive(image, sat, left_tracker);
+        } else if (right_tracker->is_active) {
+            trace_single_step_adaptive(image, sat, right_tracker);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+// 自适应阈值的两种工作方式
+typedef enum {
+    ADAPTIVE_MODE_LAZY = 0,   // 逐点查询：只在起点搜索扫描到的行和循迹探测的像素上计算局部阈值
+    ADAPTIVE_MODE_FULL_FRAME  // 全帧二值化：先对所有像素计算局部阈值，再走压缩帧流程
+} AdaptiveMode;
+
+static AdaptiveMode adaptive_mode = ADAPTIVE_MODE_LAZY;
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（局部自适应阈值版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      适用于赛道局部处于阴影或反光的场景。两种模式的循迹结果一致，
+//               本帧的局部阈值查询次数记录在 integral_image.queries 中，可用于比较两种模式的开销。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 构建积分图 ---
+    integral_image_build(mt9v03x_image_copy[0], &integral_image);
+
+    if (adaptive_mode == ADAPTIVE_MODE_FULL_FRAME)
+    {
+        // --- 2a. 全帧自适应二值化后走压缩帧流程 ---
+        adaptive_binarize_and_pack(mt9v03x_image_copy[0], &integral_image, &binary_frame);
+        if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+            return;
+        }
+        adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+        search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+    }
+    else
+    {
+        // --- 2b. 逐点查询局部阈值 ---
+        if (!get_start_point_adaptive(mt9v03x_image_copy[0], &integral_image,
+                                      &context->left_edge.start_point, &context->right_edge.start_point)) {
+            return;
+        }
+        adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+        search_line_adaptive(mt9v03x_image_copy[0], &integral_image, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+    }
+
+    // --- 3. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
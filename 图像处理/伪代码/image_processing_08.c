@@ -0,0 +1,310 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 起点帧间跟踪：在上一帧起点附近的小窗口内优先验证，失败时才退回全图扫描
+#define START_SEED_ROW_RADIUS 3 // 以上一帧起点所在行为中心，上下各检查的行数
+#define START_SEED_COL_RADIUS 6 // 以上一帧起点的x为中心，左右各检查的列数
+#define START_SEED_REFRESH_FRAMES 16 // 快速路径连续命中该帧数后强制做一次全图扫描，防止起点漂移后回不来
+
+typedef struct {
+    point    last_left;    // 上一帧的左起点
+    point    last_right;   // 上一帧的右起点
+    bool     is_valid;     // 上一帧是否成功找到起点
+    uint8_t  frames_since_scan; // 距上一次全图扫描的帧数
+    // --- 统计 ---
+    uint32_t hit_count;    // 快速路径命中次数
+    uint32_t miss_count;   // 退回全图扫描的次数
+    uint16_t pixel_reads;  // 本帧快速路径读取的像素数
+} StartPointSeed;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 起点的帧间跟踪状态
+    StartPointSeed start_seed;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在一行的小窗口内查找左边界或右边界
+// 参数说明      row_ptr       行首地址
+// 参数说明      center_x      窗口中心
+// 参数说明      polarity      EDGE_LEFT 查找“黑,黑,白,白”，EDGE_RIGHT 查找“白,白,黑,黑”
+// 参数说明      out_x         输出：找到的x坐标
+// 参数说明      reads         累加读取的像素数
+// 返回参数      bool          找到则返回true
+// 备注信息      与 get_start_point 相同，先检查赛道紧贴图像边缘的特殊情况，再在窗口内按模式匹配。
+// 备注信息      只看窗口，不看窗口左侧：get_start_point 取的是整行最靠左的匹配，窗口左侧还有匹配时 (例如赛道外的白色噪点)
+//               两者给出的x不同，此时窗口给出的是靠近上一帧边界的那一个。
+//-------------------------------------------------------------------------------------------------------------------
+static bool seed_match_in_window(const uint8_t *row_ptr, uint8_t center_x, EdgePolarity polarity,
+                                 uint8_t *out_x, uint16_t *reads)
+{
+    const uint8_t first = (polarity == EDGE_LEFT) ? IMAGE_BLACK : IMAGE_WHITE;
+    const uint8_t second = (polarity == EDGE_LEFT) ? IMAGE_WHITE : IMAGE_BLACK;
+    const int edge_x = (polarity == EDGE_LEFT) ? 1 : IMAGE_W - 2;
+    const int edge_neighbor = (polarity == EDGE_LEFT) ? 2 : IMAGE_W - 3;
+
+    // 1. 紧贴图像边缘的特殊情况
+    (*reads)++;
+    if (row_ptr[edge_x] == IMAGE_WHITE)
+    {
+        (*reads)++;
+        if (row_ptr[edge_neighbor] == IMAGE_WHITE)
+        {
+            *out_x = (uint8_t)edge_x;
+            return true;
+        }
+    }
+
+    // 2. 窗口内的模式匹配，窗口被裁剪到 get_start_point 的合法区间 [1, IMAGE_W - 4]
+    int x_begin = center_x - START_SEED_COL_RADIUS;
+    int x_end = center_x + START_SEED_COL_RADIUS;
+    if (x_begin < 1) x_begin = 1;
+    if (x_end > IMAGE_W - 4) x_end = IMAGE_W - 4;
+
+    for (int x = x_begin; x <= x_end; x++)
+    {
+        // 逐个像素短路比较，并统计实际读取的像素数
+        (*reads)++;
+        if (row_ptr[x] != first) continue;
+        (*reads)++;
+        if (row_ptr[x + 1] != first) continue;
+        (*reads)++;
+        if (row_ptr[x + 2] != second) continue;
+        (*reads)++;
+        if (row_ptr[x + 3] != second) continue;
+
+        *out_x = (uint8_t)x;
+        return true;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在一行内按左右两个列窗口同时查找左右边界
+// 参数说明      image         图像数据指针
+// 参数说明      seed          起点跟踪状态，累加其中的读取像素数
+// 参数说明      y             行号
+// 参数说明      left_center   左窗口中心
+// 参数说明      right_center  右窗口中心
+// 参数说明      left_x        输出：左边界x
+// 参数说明      right_x       输出：右边界x
+// 返回参数      bool          左右都找到且赛道宽度大于10像素返回true
+//-------------------------------------------------------------------------------------------------------------------
+static bool seed_match_row(const uint8_t *image, StartPointSeed *seed, int y, uint8_t left_center, uint8_t right_center,
+                           uint8_t *left_x, uint8_t *right_x)
+{
+    const uint8_t *row_ptr = image + y * IMAGE_W;
+    return seed_match_in_window(row_ptr, left_center, EDGE_LEFT, left_x, &seed->pixel_reads) &&
+           seed_match_in_window(row_ptr, right_center, EDGE_RIGHT, right_x, &seed->pixel_reads) &&
+           (*right_x - *left_x) > 10;
+}
+
+bool get_start_point(const uint8_t *image, point *p_left, point *p_right); // 实现见 image_processing_01.c
+void search_line(const uint8_t* image, EdgeTracker* left_tracker, EdgeTracker* right_tracker, uint16_t max_iterations); // 实现见 image_processing_02.c
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      带帧间跟踪的起始点搜索
+// 参数说明      image         待处理的只读图像数据指针 (const uint8_t *)
+// 参数说明      seed          起点跟踪状态（跨帧保存）
+// 参数说明      p_left        用于存储左边界起点坐标的指针 (point *)
+// 参数说明      p_right       用于存储右边界起点坐标的指针 (point *)
+// 返回参数      bool          如果同时找到左右边界则返回true，否则返回false
+// 备注信息      快速路径：以上一帧起点为中心，从窗口最下方的行开始向上，只检查左右起点附近的几列，
+//               同样要求赛道宽度大于10像素。直道上通常在第一行就能命中，只需读取几十个像素。
+// 备注信息      全图扫描取的是最靠下的匹配行，快速路径尽量给出同一行：
+//               1. 命中行不是窗口最下面一行，说明起点上移了，窗口内的结果可能与全图扫描不同，退回全图扫描；
+//               2. 命中在窗口最下面一行而下方还有行 (上一帧起点偏高，例如干扰帧之后)，继续逐行向下跟踪，
+//                  每一行的列窗口以上一行的命中点为中心，直到下一行不再匹配，一帧内就能回到底部，
+//                  而不是每帧只下移 START_SEED_ROW_RADIUS 行。
+// 备注信息      快速路径与全图扫描并不总是相同，已知的两种差别：
+//               1. 同一行内窗口左侧还有匹配 (赛道外的噪点、另一条赛道)，全图扫描取最靠左的，快速路径取窗口内的；
+//                  噪点让全图扫描的宽度校验失败而上移一行时，两者的行号也会不同；
+//               2. 向下跟踪停止的那一行之下隔行又出现匹配 (例如遮挡消失)，快速路径看不到，给出的行偏上。
+//               快速路径连续命中 START_SEED_REFRESH_FRAMES 帧后强制全图扫描一次，第2种差别最多持续这么多帧。
+// 备注信息      快速路径失败（或上一帧没有起点）时退回 get_start_point 全图扫描。
+//-------------------------------------------------------------------------------------------------------------------
+bool get_start_point_seeded(const uint8_t *image, StartPointSeed *seed, point *p_left, point *p_right)
+{
+    seed->pixel_reads = 0;
+
+    // --- 1. 快速路径：在上一帧起点附近验证 ---
+    if (seed->is_valid && seed->frames_since_scan < START_SEED_REFRESH_FRAMES)
+    {
+        int y_bottom = seed->last_left.y + START_SEED_ROW_RADIUS;
+        int y_top = seed->last_left.y - START_SEED_ROW_RADIUS;
+        if (y_bottom > IMAGE_H - 2) y_bottom = IMAGE_H - 2;
+        if (y_top < 1) y_top = 1;
+
+        for (int y = y_bottom; y >= y_top; y--)
+        {
+            uint8_t left_x, right_x;
+            if (!seed_match_row(image, seed, y, seed->last_left.x, seed->last_right.x, &left_x, &right_x))
+            {
+                continue;
+            }
+            if (y != y_bottom)
+            {
+                break; // 命中行不在窗口最下面一行，退回全图扫描
+            }
+
+            // 匹配可能延伸到窗口下方，跟到最靠下的匹配行
+            uint8_t below_left, below_right;
+            while (y < IMAGE_H - 2 && seed_match_row(image, seed, y + 1, left_x, right_x, &below_left, &below_right))
+            {
+                y++;
+                left_x = below_left;
+                right_x = below_right;
+            }
+
+            p_left->x = left_x;
+            p_left->y = (uint8_t)y;
+            p_right->x = right_x;
+            p_right->y = (uint8_t)y;
+
+            seed->last_left = *p_left;
+            seed->last_right = *p_right;
+            seed->hit_count++;
+            seed->frames_since_scan++;
+            return true;
+        }
+    }
+
+    // --- 2. 慢速路径：全图扫描 ---
+    seed->miss_count++;
+    seed->frames_since_scan = 0;
+    seed->is_valid = get_start_point(image, p_left, p_right);
+    if (seed->is_valid)
+    {
+        seed->last_left = *p_left;
+        seed->last_right = *p_right;
+    }
+    return seed->is_valid;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（起点帧间跟踪版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      context->start_seed 需要跨帧保留；命中率可由 hit_count / (hit_count + miss_count) 得到。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128; // 可以为左右设置不同阈值
+    // 优先在上一帧起点附近查找，失败时才做全图扫描
+    if (!get_start_point_seeded(mt9v03x_image_copy[0], &context->start_seed,
+                                &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return; // 如果找不到起始点，则直接退出本次处理
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 2. 执行阶段 ---
+    search_line(mt9v03x_image_copy[0], &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 3. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
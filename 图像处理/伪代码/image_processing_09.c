@@ -0,0 +1,409 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// ROI 循迹参数
+#define ROI_BASE_MARGIN      8   // 走廊在上一帧边线两侧各扩展的像素数
+#define ROI_MAX_WIDEN        2   // 失败后走廊加宽 (边距翻倍) 的最大次数，之后退回全图
+#define ROI_MIN_TRACE_POINTS 20  // ROI 循迹得到的点数少于该值视为丢线
+
+// 每条边在每一行允许出现的x范围 [min_x, max_x]
+typedef struct {
+    uint8_t min_x[IMAGE_H];
+    uint8_t max_x[IMAGE_H];
+} RowCorridor;
+
+typedef struct {
+    RowCorridor left;        // 左边线走廊
+    RowCorridor right;       // 右边线走廊
+    bool        is_valid;    // 上一帧是否有可用的左右边线
+    // --- 统计 ---
+    bool        used_roi;    // 本帧最终是否在 ROI 内完成循迹
+    uint8_t     widen_count; // 本帧走廊加宽次数
+    uint32_t    pixel_reads; // 本帧起点搜索与循迹读取的像素总数
+    uint32_t    roi_frames;  // 累计在 ROI 内完成的帧数
+    uint32_t    full_frames; // 累计退回全图的帧数
+} RoiTracking;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 感兴趣区域 (ROI) 循迹状态
+    RoiTracking roi;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      由上一帧的 filtered_edge 构建每行的走廊
+// 参数说明      tracker       上一帧的边缘跟踪器（只读取 filtered_edge）
+// 参数说明      corridor      输出的走廊
+// 参数说明      margin        边线两侧扩展的像素数
+// 备注信息      上一帧没有覆盖到的行不做限制（整行开放），循迹越过上一帧的范围后即恢复为普通循迹。
+// 备注信息      必须在本帧 extract_and_filter_edges 覆盖 filtered_edge 之前调用。
+//-------------------------------------------------------------------------------------------------------------------
+static void build_row_corridor(const EdgeTracker *tracker, RowCorridor *corridor, uint8_t margin)
+{
+    memset(corridor->min_x, 0, sizeof(corridor->min_x));
+    memset(corridor->max_x, IMAGE_W - 1, sizeof(corridor->max_x));
+
+    for (int i = 0; i < tracker->filtered_points_count; i++)
+    {
+        point p = tracker->filtered_edge[i];
+        corridor->min_x[p.y] = (p.x > margin) ? (uint8_t)(p.x - margin) : 0;
+        corridor->max_x[p.y] = (p.x + margin < IMAGE_W - 1) ? (uint8_t)(p.x + margin) : IMAGE_W - 1;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在走廊限定的列范围内搜索起始点
+// 参数说明      image         待处理的只读图像数据指针 (const uint8_t *)
+// 参数说明      left_roi      左边线走廊，为 NULL 时整行搜索
+// 参数说明      right_roi     右边线走廊，为 NULL 时整行搜索
+// 参数说明      p_left        用于存储左边界起点坐标的指针 (point *)
+// 参数说明      p_right       用于存储右边界起点坐标的指针 (point *)
+// 参数说明      reads         累加读取的像素数
+// 返回参数      bool          如果同时找到左右边界则返回true，否则返回false
+// 备注信息      判定规则与 get_start_point 相同；两个走廊都为 NULL 时结果与 get_start_point 一致。
+//-------------------------------------------------------------------------------------------------------------------
+bool get_start_point_roi(const uint8_t *image, const RowCorridor *left_roi, const RowCorridor *right_roi,
+                         point *p_left, point *p_right, uint32_t *reads)
+{
+    for (int y = IMAGE_H - 2; y > 0; y--)
+    {
+        const uint8_t *row_ptr = image + y * IMAGE_W;
+        bool l_found = false;
+        bool r_found = false;
+
+        // 紧贴图像边缘的特殊情况
+        *reads += 4;
+        if (row_ptr[1] == IMAGE_WHITE && row_ptr[2] == IMAGE_WHITE)
+        {
+            l_found = true;
+            p_left->x = 1;
+            p_left->y = y;
+        }
+        if (row_ptr[IMAGE_W - 2] == IMAGE_WHITE && row_ptr[IMAGE_W - 3] == IMAGE_WHITE)
+        {
+            r_found = true;
+            p_right->x = IMAGE_W - 2;
+            p_right->y = y;
+        }
+
+        // 左右边界分别只在各自的走廊内查找，并裁剪到合法区间 [1, IMAGE_W - 4]
+        int l_begin = left_roi ? left_roi->min_x[y] : 1;
+        int l_end = left_roi ? left_roi->max_x[y] : IMAGE_W - 4;
+        int r_begin = right_roi ? right_roi->min_x[y] : 1;
+        int r_end = right_roi ? right_roi->max_x[y] : IMAGE_W - 4;
+        if (l_begin < 1) l_begin = 1;
+        if (r_begin < 1) r_begin = 1;
+        if (l_end > IMAGE_W - 4) l_end = IMAGE_W - 4;
+        if (r_end > IMAGE_W - 4) r_end = IMAGE_W - 4;
+
+        for (int x = l_begin; !l_found && x <= l_end; x++)
+        {
+            *reads += 4;
+            if (row_ptr[x] == IMAGE_BLACK && row_ptr[x + 1] == IMAGE_BLACK
+                && row_ptr[x + 2] == IMAGE_WHITE && row_ptr[x + 3] == IMAGE_WHITE)
+            {
+                l_found = true;
+                p_left->x = x;
+                p_left->y = y;
+            }
+        }
+        for (int x = r_begin; !r_found && x <= r_end; x++)
+        {
+            *reads += 4;
+            if (row_ptr[x] == IMAGE_WHITE && row_ptr[x + 1] == IMAGE_WHITE
+                && row_ptr[x + 2] == IMAGE_BLACK && row_ptr[x + 3] == IMAGE_BLACK)
+            {
+                r_found = true;
+                p_right->x = x;
+                p_right->y = y;
+            }
+        }
+
+        if (l_found && r_found && (p_right->x - p_left->x) > 10)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（ROI 版本）
+// 参数说明      image         图像数据指针
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 参数说明      corridor      该边线的走廊，为 NULL 时不做限制
+// 参数说明      reads         累加读取的像素数
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      搜索顺序与 trace_single_step 相同。新点总是探测点 a1，因此先判断 a1 是否在走廊内，
+//               不在走廊内的探测直接跳过，不读取像素，循迹也就不会离开走廊。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_roi(const uint8_t *image, EdgeTracker *tracker, const RowCorridor *corridor, uint32_t *reads)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    point a0, a1;
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        a1.x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        a1.y = tracker->current_point.y + tracker->grow_table[dir1].y;
+        if (corridor && (a1.y >= IMAGE_H || a1.x < corridor->min_x[a1.y] || a1.x > corridor->max_x[a1.y]))
+        {
+            continue; // 落在走廊外，跳过本次探测
+        }
+        a0.x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        a0.y = tracker->current_point.y + tracker->grow_table[dir0].y;
+
+        (*reads)++;
+        if (image[a0.y * IMAGE_W + a0.x] >= tracker->threshold)
+        {
+            continue;
+        }
+        (*reads)++;
+        if (image[a1.y * IMAGE_W + a1.x] > tracker->threshold)
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point = a1;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（ROI 版本）
+// 参数说明      left_roi / right_roi  左右边线的走廊，为 NULL 时不做限制
+// 参数说明      reads                 累加读取的像素数
+// 备注信息      调度策略和终止条件与 search_line 相同。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_roi(const uint8_t *image, EdgeTracker *left_tracker, EdgeTracker *right_tracker,
+                     const RowCorridor *left_roi, const RowCorridor *right_roi,
+                     uint16_t max_iterations, uint32_t *reads)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_roi(image, left_tracker, left_roi, reads);
+            } else {
+                trace_single_step_roi(image, right_tracker, right_roi, reads);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_roi(image, left_tracker, left_roi, reads);
+        } else if (right_tracker->is_active) {
+            trace_single_step_roi(image, right_tracker, right_roi, reads);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在上一帧边线的走廊内完成起点搜索和循迹，失败时逐级加宽，最后退回全图
+// 参数说明      context       指向TrackContext的指针
+// 返回参数      bool          成功找到起点并完成循迹返回true
+// 备注信息      左右两边都追踪到至少 ROI_MIN_TRACE_POINTS 个点才认为 ROI 循迹成功，否则视为丢线。
+//-------------------------------------------------------------------------------------------------------------------
+static bool search_line_with_roi(TrackContext *context)
+{
+    RoiTracking *roi = &context->roi;
+    EdgeTracker *left = &context->left_edge;
+    EdgeTracker *right = &context->right_edge;
+    const uint8_t *image = mt9v03x_image_copy[0];
+
+    roi->pixel_reads = 0;
+    roi->widen_count = 0;
+    roi->used_roi = false;
+
+    // --- 1. 在走廊内循迹，丢线时边距翻倍后重试 ---
+    if (roi->is_valid)
+    {
+        uint8_t margin = ROI_BASE_MARGIN;
+        for (uint8_t attempt = 0; attempt <= ROI_MAX_WIDEN; attempt++)
+        {
+            build_row_corridor(left, &roi->left, margin);
+            build_row_corridor(right, &roi->right, margin);
+
+            if (get_start_point_roi(image, &roi->left, &roi->right, &left->start_point, &right->start_point, &roi->pixel_reads))
+            {
+                adjust_start_point_for_trace(&left->start_point, &right->start_point);
+                search_line_roi(image, left, right, &roi->left, &roi->right, MAX_EDGE_POINTS * 2, &roi->pixel_reads);
+                if (left->raw_points_count >= ROI_MIN_TRACE_POINTS && right->raw_points_count >= ROI_MIN_TRACE_POINTS)
+                {
+                    roi->used_roi = true;
+                    roi->roi_frames++;
+                    return true;
+                }
+            }
+            roi->widen_count++;
+            margin *= 2;
+        }
+    }
+
+    // --- 2. 全图回退 ---
+    roi->full_frames++;
+    if (!get_start_point_roi(image, NULL, NULL, &left->start_point, &right->start_point, &roi->pixel_reads))
+    {
+        return false;
+    }
+    adjust_start_point_for_trace(&left->start_point, &right->start_point);
+    search_line_roi(image, left, right, NULL, NULL, MAX_EDGE_POINTS * 2, &roi->pixel_reads);
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（ROI 循迹版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      context->roi.pixel_reads 记录每帧的像素读取数，可按 used_roi 分组与全图帧对比节省量。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128; // 可以为左右设置不同阈值
+
+    // --- 2. 执行阶段：走廊由上一帧的 filtered_edge 构建，必须在结果处理之前完成 ---
+    if (!search_line_with_roi(context)) {
+        context->roi.is_valid = false;
+        return; // 如果找不到起始点，则直接退出本次处理
+    }
+
+    // --- 3. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+    // 只有左右两边都提取到有效边线时，下一帧才使用 ROI
+    context->roi.is_valid = context->left_edge.is_found && context->right_edge.is_found;
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
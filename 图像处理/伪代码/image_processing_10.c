@@ -0,0 +1,373 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// Q16.16 定点数：高16位为整数部分，低16位为小数部分
+#define Q16_ONE (1 << 16)
+typedef struct {
+    int32_t x;
+    int32_t y;
+} point_q16;
+// 三阶贝塞尔曲线的定点版本，用于无 FPU 的平台
+typedef struct {
+    point_q16 p0, p1, p2, p3;
+} CubicBezierQ16;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 行列式判零阈值：与浮点版本的 1e-6 对应，行列式以 Q32 表示时约为 1e-6 * 2^32
+#define BEZIER_Q16_DET_EPS 4295
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      64位整数开平方（逐位法）
+// 参数说明      v             被开方数
+// 返回参数      uint32_t      floor(sqrt(v))
+// 备注信息      只用移位、加减和比较，没有乘除法；从最高有效位开始迭代，小数值时循环次数更少。
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t isqrt_u64(uint64_t v)
+{
+    uint64_t result = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > v)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (v >= result + bit)
+        {
+            v -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+// 小距离平方的开方表：sqrt_q16_table[k] = floor(sqrt(k) * 2^16)。
+// filtered_edge 相邻两点的 |dy| = 1 且 |dx| <= MAX_EDGE_HORIZONTAL_JUMP (8)，d² 不超过 65，绝大多数情况可直接查表。
+#define SQRT_Q16_TABLE_SIZE 66
+static const uint32_t sqrt_q16_table[SQRT_Q16_TABLE_SIZE] = {
+    0u, 65536u, 92681u, 113511u, 131072u, 146542u, 160529u, 173391u,
+    185363u, 196608u, 207243u, 217358u, 227023u, 236293u, 245213u, 253819u,
+    262144u, 270211u, 278045u, 285664u, 293085u, 300323u, 307391u, 314299u,
+    321059u, 327680u, 334169u, 340535u, 346783u, 352922u, 358955u, 364889u,
+    370727u, 376475u, 382137u, 387716u, 393216u, 398639u, 403991u, 409272u,
+    414486u, 419635u, 424721u, 429748u, 434716u, 439628u, 444486u, 449292u,
+    454046u, 458752u, 463409u, 468020u, 472586u, 477109u, 481589u, 486027u,
+    490426u, 494785u, 499107u, 503391u, 507639u, 511852u, 516030u, 520175u,
+    524288u, 528368u
+};
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      两个整数点之间的距离 (Q16)
+// 备注信息      sqrt(d² * 2^32) = d * 2^16，d² 最大为 2*255²，左移32位后仍在 uint64_t 范围内。
+//               d² 较小时查表，否则调用整数开方。
+//-------------------------------------------------------------------------------------------------------------------
+static uint32_t distance_q16(point a, point b)
+{
+    int32_t dx = (int32_t)a.x - b.x;
+    int32_t dy = (int32_t)a.y - b.y;
+    uint32_t d2 = (uint32_t)(dx * dx + dy * dy);
+    if (d2 < SQRT_Q16_TABLE_SIZE)
+    {
+        return sqrt_q16_table[d2];
+    }
+    return isqrt_u64((uint64_t)d2 << 32);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      Q32 除法得到 Q16 结果：(num * 2^16) / den
+// 参数说明      out           输出的 Q16 结果
+// 返回参数      bool          结果超出 int32_t 范围 (约 ±32768 像素) 时返回false，out 不变
+// 备注信息      num 可能超过 2^47，直接左移会溢出，因此拆成商和余数两部分分别计算。要求 den > 0。
+//               |num| < 2^51 且 den > BEZIER_Q16_DET_EPS 时商不超过 2^39，两部分在 int64_t 内都不会溢出，
+//               溢出只可能发生在最后收窄到 int32_t 时，这里先检查范围。
+//-------------------------------------------------------------------------------------------------------------------
+static bool div_q16(int64_t num, int64_t den, int32_t *out)
+{
+    int64_t q = num / den;
+    int64_t r = num % den;
+    int64_t v = q * Q16_ONE + (r * Q16_ONE) / den;
+    if (v > INT32_MAX || v < INT32_MIN)
+    {
+        return false;
+    }
+    *out = (int32_t)v;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      将一系列离散点拟合为一条三阶贝塞尔曲线（Q16 定点版本）
+// 参数说明      points        输入的离散点数组 (类型为原始的 point)
+// 参数说明      count         输入的点的数量，不超过 IMAGE_H
+// 返回参数      CubicBezierQ16 计算得到的贝塞尔曲线，控制点为 Q16 定点数
+// 备注信息      算法与 fit_bezier_curve 相同（首尾点固定 + 弦长参数化 + 2x2 最小二乘），全部使用整数运算：
+//               1. 弦长用整数开方求得 (Q16)，t = 累积弦长 * (2^48 / 总弦长) >> 32，整个拟合只做一次64位除法。
+//               2. 基函数为 Q16，C 和 X 以 Q32 累加到 int64_t 中，不会溢出。
+//               3. 求解前把 C、X 降为 Q16，此时行列式不超过 2^42，分子不超过 2^51，克莱姆法则在 int64_t 内完成。
+// 备注信息      在 count <= IMAGE_H 的前提下保证不溢出。与浮点版本相比，拟合曲线上的最大偏差约为 0.03 像素，
+//               主要来自基函数和 t 的 Q16 量化。
+//-------------------------------------------------------------------------------------------------------------------
+CubicBezierQ16 fit_bezier_curve_q16(const point* points, int count)
+{
+    CubicBezierQ16 bezier;
+
+    if (count < 2) {
+        bezier.p0 = bezier.p1 = bezier.p2 = bezier.p3 = (point_q16){0, 0};
+        return bezier;
+    }
+
+    // --- 1. 确定 P0 和 P3 ---
+    bezier.p0 = (point_q16){(int32_t)points[0].x * Q16_ONE, (int32_t)points[0].y * Q16_ONE};
+    bezier.p3 = (point_q16){(int32_t)points[count - 1].x * Q16_ONE, (int32_t)points[count - 1].y * Q16_ONE};
+
+    // --- 2. 第一遍：总弦长 (Q16) ---
+    uint32_t total_length = 0;
+    for (int i = 1; i < count; i++) {
+        total_length += distance_q16(points[i], points[i - 1]);
+    }
+    // 用倒数代替逐点除法：t = acc * inv_total >> 32。
+    // 倒数取 2^48 / total 而不是 2^32 / total，否则 100 多像素长的边线倒数只有约9位有效数字，t 的误差会达到 0.2%。
+    uint64_t inv_total = (total_length > 0) ? (((uint64_t)1 << 48) / total_length) : 0;
+
+    // --- 3. 第二遍：t 值、基函数和最小二乘累加 ---
+    int64_t C00 = 0, C01 = 0, C11 = 0;          // Q32
+    int64_t X0x = 0, X0y = 0, X1x = 0, X1y = 0; // Q32
+    uint32_t accumulated_length = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (i > 0) {
+            accumulated_length += distance_q16(points[i], points[i - 1]);
+        }
+        uint32_t t = (uint32_t)((accumulated_length * inv_total) >> 32);
+        if (t > Q16_ONE) t = Q16_ONE;
+        uint32_t t_inv = Q16_ONE - t;
+
+        // 贝塞尔基函数 (Q16)
+        uint32_t t2 = (uint32_t)(((uint64_t)t * t) >> 16);
+        uint32_t t_inv2 = (uint32_t)(((uint64_t)t_inv * t_inv) >> 16);
+        int32_t b0 = (int32_t)(((uint64_t)t_inv2 * t_inv) >> 16);
+        int32_t b1 = (int32_t)((3 * (uint64_t)t * t_inv2) >> 16);
+        int32_t b2 = (int32_t)((3 * (uint64_t)t2 * t_inv) >> 16);
+        int32_t b3 = (int32_t)(((uint64_t)t2 * t) >> 16);
+
+        C00 += (int64_t)b1 * b1;
+        C01 += (int64_t)b1 * b2;
+        C11 += (int64_t)b2 * b2;
+
+        // d' = 点 - (b0 * P0 + b3 * P3)，Q16；端点坐标为整数，乘积不超过 2^24
+        int32_t dx = (int32_t)points[i].x * Q16_ONE - (b0 * (int32_t)points[0].x + b3 * (int32_t)points[count - 1].x);
+        int32_t dy = (int32_t)points[i].y * Q16_ONE - (b0 * (int32_t)points[0].y + b3 * (int32_t)points[count - 1].y);
+        X0x += (int64_t)b1 * dx;
+        X0y += (int64_t)b1 * dy;
+        X1x += (int64_t)b2 * dx;
+        X1y += (int64_t)b2 * dy;
+    }
+
+    // --- 4. 降为 Q16 后用克莱姆法则求解 ---
+    C00 >>= 16; C01 >>= 16; C11 >>= 16;
+    X0x >>= 16; X0y >>= 16; X1x >>= 16; X1y >>= 16;
+
+    // 降为 Q16 时每项截断误差不到 1，行列式因此可能偏离 C00 + C11 + 2|C01|。只有3个点等秩为1的情形，
+    // 精确的行列式为0，截断后却可能大于 BEZIER_Q16_DET_EPS，所以判零阈值要加上这部分误差。
+    int64_t det_C = C00 * C11 - C01 * C01; // Q32
+    int64_t det_eps = BEZIER_Q16_DET_EPS + C00 + C11 + 2 * (C01 < 0 ? -C01 : C01);
+    bool solved = false;
+    if (det_C > det_eps || det_C < -det_eps) {
+        if (det_C < 0) { // 统一为正分母，便于 div_q16 的取整
+            det_C = -det_C;
+            C00 = -C00; C01 = -C01; C11 = -C11;
+        }
+        // 行列式刚过阈值时控制点可能远在图像之外，超出 Q16 的表示范围，此时与行列式过小一样按共线处理
+        solved = div_q16(X0x * C11 - X1x * C01, det_C, &bezier.p1.x) &&
+                 div_q16(X0y * C11 - X1y * C01, det_C, &bezier.p1.y) &&
+                 div_q16(X1x * C00 - X0x * C01, det_C, &bezier.p2.x) &&
+                 div_q16(X1y * C00 - X0y * C01, det_C, &bezier.p2.y);
+    }
+    if (!solved) { // 行列式为0或非常小，说明所有点可能共线
+        bezier.p1 = (point_q16){(2 * bezier.p0.x + bezier.p3.x) / 3, (2 * bezier.p0.y + bezier.p3.y) / 3};
+        bezier.p2 = (point_q16){(bezier.p0.x + 2 * bezier.p3.x) / 3, (bezier.p0.y + 2 * bezier.p3.y) / 3};
+    }
+
+    return bezier;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      Q16 贝塞尔曲线转换为浮点版本
+// 备注信息      只在结果交给浮点代码时调用，每条曲线8次整数到浮点的转换。
+//-------------------------------------------------------------------------------------------------------------------
+static point_f point_q16_to_f(point_q16 p)
+{
+    return (point_f){(float)p.x / Q16_ONE, (float)p.y / Q16_ONE};
+}
+
+CubicBezier bezier_q16_to_float(const CubicBezierQ16 *q)
+{
+    CubicBezier bezier;
+    bezier.p0 = point_q16_to_f(q->p0);
+    bezier.p1 = point_q16_to_f(q->p1);
+    bezier.p2 = point_q16_to_f(q->p2);
+    bezier.p3 = point_q16_to_f(q->p3);
+    return bezier;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      调度左右两条边的贝塞尔曲线拟合（定点版本）
+// 备注信息      结果写入与浮点版本相同的 left_bezier / right_bezier，后续代码无需改动。
+//-------------------------------------------------------------------------------------------------------------------
+void fit_edges_with_bezier_q16(TrackContext *context) {
+    CubicBezierQ16 q;
+
+    // 拟合左边缘
+    if (context->left_edge.is_found && context->left_edge.filtered_points_count >= 4) {
+        q = fit_bezier_curve_q16(context->left_edge.filtered_edge, context->left_edge.filtered_points_count);
+        context->left_bezier = bezier_q16_to_float(&q);
+        context->left_bezier_found = true;
+    } else {
+        context->left_bezier_found = false;
+    }
+
+    // 拟合右边缘
+    if (context->right_edge.is_found && context->right_edge.filtered_points_count >= 4) {
+        q = fit_bezier_curve_q16(context->right_edge.filtered_edge, context->right_edge.filtered_points_count);
+        context->right_bezier = bezier_q16_to_float(&q);
+        context->right_bezier_found = true;
+    } else {
+        context->right_bezier_found = false;
+    }
+}
+
+bool get_start_point(const uint8_t *image, point *p_left, point *p_right); // 实现见 image_processing_01.c
+void search_line(const uint8_t* image, EdgeTracker* left_tracker, EdgeTracker* right_tracker, uint16_t max_iterations); // 实现见 image_processing_02.c
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（定点贝塞尔拟合版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      用于没有 FPU 的副控板，除最后的结果转换外，拟合全程不使用浮点运算。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128; // 可以为左右设置不同阈值
+    // 调用函数查找循迹的起始点
+    if (!get_start_point(mt9v03x_image_copy[0], &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return; // 如果找不到起始点，则直接退出本次处理
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 2. 执行阶段 ---
+    search_line(mt9v03x_image_copy[0], &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 3. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 4. 曲线拟合阶段（定点） ---
+    fit_edges_with_bezier_q16(context);
+}
\ No newline at end of file
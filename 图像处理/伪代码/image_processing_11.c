@@ -0,0 +1,331 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 周期计数器：在 Cortex-M4 上可定义为 (DWT->CYCCNT)，未定义时各阶段的周期统计恒为0
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u
+#endif
+
+// 行地图构建方式：1 = 在循迹过程中同步维护，0 = 循迹结束后由 convert_edge_to_row_map_first_point 单独转换
+#ifndef ROW_MAP_FUSED
+#define ROW_MAP_FUSED 1
+#endif
+
+// 各阶段耗时统计 (周期)，用于对比两种行地图构建方式
+typedef struct {
+    uint32_t trace_cycles;   // 起点搜索之后的循迹耗时（融合模式下包含行地图维护）
+    uint32_t row_map_cycles; // 独立行地图转换耗时（融合模式下为0）
+    uint32_t extract_cycles; // 边缘提纯与距离计算耗时
+} StageTiming;
+
+static StageTiming stage_timing;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      循迹新增一个点时同步更新行地图
+// 参数说明      tracker       边缘跟踪器
+// 参数说明      p             新增的点
+// 备注信息      每步最多移动一行，已访问的行总是连续区间 [mapped_edge_end_y, mapped_edge_start_y]，
+//               因此“该行是否首次访问”只需与区间端点比较，不再需要 memset 清零整张行地图。
+//               x == 0 视为未写入，与 convert_edge_to_row_map_first_point 的约定保持一致。
+//-------------------------------------------------------------------------------------------------------------------
+static inline void row_map_append(EdgeTracker *tracker, point p)
+{
+    if (p.y >= IMAGE_H)
+    {
+        return; // 越过图像上下边界回绕的点不写入，防止行地图越界
+    }
+    if (p.y < tracker->mapped_edge_end_y)
+    {
+        tracker->mapped_edge_end_y = p.y;     // 向上进入新的一行
+        tracker->mapped_edge[p.y] = p.x;
+    }
+    else if (p.y > tracker->mapped_edge_start_y)
+    {
+        tracker->mapped_edge_start_y = p.y;   // 向下进入新的一行
+        tracker->mapped_edge[p.y] = p.x;
+    }
+    else if (tracker->mapped_edge[p.y] == 0)
+    {
+        tracker->mapped_edge[p.y] = p.x;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（同步维护行地图）
+// 参数说明      image         图像数据指针
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      搜索过程与 trace_single_step 相同，新点写入 raw_edge_points 的同时写入行地图。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_fused(const uint8_t* image, EdgeTracker* tracker)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    point a0, a1;
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        a0.x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        a0.y = tracker->current_point.y + tracker->grow_table[dir0].y;
+        a1.x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        a1.y = tracker->current_point.y + tracker->grow_table[dir1].y;
+
+        if (image[a0.y * IMAGE_W + a0.x] < tracker->threshold &&
+            image[a1.y * IMAGE_W + a1.x] > tracker->threshold)
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point.x += tracker->grow_table[dir1].x;
+            tracker->current_point.y += tracker->grow_table[dir1].y;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            row_map_append(tracker, tracker->current_point); // 同步维护行地图
+
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      初始化跟踪器的循迹状态和行地图
+// 备注信息      行地图只写入起点所在的一行，区间两端都从起点行开始。
+//-------------------------------------------------------------------------------------------------------------------
+static void tracker_begin_fused(EdgeTracker *tracker)
+{
+    tracker->raw_points_count = 0;
+    tracker->current_point = tracker->start_point;
+    tracker->raw_edge_points[0] = tracker->start_point;
+    tracker->raw_direction[0] = 0;
+    tracker->is_active = true;
+
+    tracker->mapped_edge_start_y = tracker->start_point.y;
+    tracker->mapped_edge_end_y = tracker->start_point.y;
+    tracker->mapped_edge[tracker->start_point.y] = tracker->start_point.x;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（同步维护行地图）
+// 备注信息      调度策略和终止条件与 search_line 相同；结束后 mapped_edge、mapped_edge_start_y、
+//               mapped_edge_end_y 已经可以直接交给 extract_reality_edge 使用。
+// 备注信息      行地图与 convert_edge_to_row_map_first_point(raw_edge_points, raw_points_count + 1, ...) 一致。
+//               raw_points_count 是最后一个点的下标，原流程直接把它当作点数传入，会漏掉最后一个点。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_fused(const uint8_t* image, EdgeTracker* left_tracker, EdgeTracker* right_tracker, uint16_t max_iterations)
+{
+    tracker_begin_fused(left_tracker);
+    tracker_begin_fused(right_tracker);
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_fused(image, left_tracker);
+            } else {
+                trace_single_step_fused(image, right_tracker);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_fused(image, left_tracker);
+        } else if (right_tracker->is_active) {
+            trace_single_step_fused(image, right_tracker);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+bool get_start_point(const uint8_t *image, point *p_left, point *p_right); // 实现见 image_processing_01.c
+void extract_reality_edge(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      边缘提纯与有效距离计算（行地图已由循迹同步生成）
+// 备注信息      与 extract_and_filter_edges 相同，但跳过 convert_edge_to_row_map_first_point。
+//               extract_single_edge 只读取 [mapped_edge_end_y, mapped_edge_start_y] 内的行，都已被写入。
+//-------------------------------------------------------------------------------------------------------------------
+void extract_and_filter_edges_fused(TrackContext *context)
+{
+    // --- 1. 执行核心边缘提纯 ---
+    extract_reality_edge(context);
+
+    // --- 2. 计算有效循迹距离 ---
+    uint8_t left_end_y = context->left_edge.mapped_edge_end_y;
+    uint8_t right_end_y = context->right_edge.mapped_edge_end_y;
+
+    if(left_end_y <= right_end_y && left_end_y > 0)
+    {
+        context->final_distance = IMAGE_H - left_end_y;
+    }
+    else if (right_end_y < left_end_y && right_end_y > 0)
+    {
+        context->final_distance = IMAGE_H - right_end_y;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（融合行地图版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      ROW_MAP_FUSED 为0时走原来的 search_line + convert_edge_to_row_map_first_point 路径，
+//               两种路径的各阶段耗时记录在 stage_timing 中。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128; // 可以为左右设置不同阈值
+    // 调用函数查找循迹的起始点
+    if (!get_start_point(mt9v03x_image_copy[0], &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return; // 如果找不到起始点，则直接退出本次处理
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+
+    uint32_t t0 = IMAGE_CYCLE_COUNTER();
+#if ROW_MAP_FUSED
+    // --- 2. 执行阶段：循迹同时生成行地图 ---
+    search_line_fused(mt9v03x_image_copy[0], &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+    uint32_t t1 = IMAGE_CYCLE_COUNTER();
+    uint32_t t2 = t1;
+
+    // --- 3. 结果处理阶段 ---
+    extract_and_filter_edges_fused(context);
+#else
+    // --- 2. 执行阶段 ---
+    search_line(mt9v03x_image_copy[0], &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+    uint32_t t1 = IMAGE_CYCLE_COUNTER();
+
+    // --- 3. 结果处理阶段：单独转换行地图后提纯 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    uint32_t t2 = IMAGE_CYCLE_COUNTER();
+    extract_and_filter_edges_fused(context);
+#endif
+    uint32_t t3 = IMAGE_CYCLE_COUNTER();
+
+    stage_timing.trace_cycles = t1 - t0;
+    stage_timing.row_map_cycles = t2 - t1;
+    stage_timing.extract_cycles = t3 - t2;
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 强制内联：让通用的单步跟踪内核在左右两个包装函数中分别展开，方向表作为编译期常量参与优化
+#if defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM)
+#define IMAGE_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define IMAGE_FORCE_INLINE inline
+#endif
+
+// 方向增量对应的线性像素偏移
+#define LINEAR_OFFSET(dx, dy) ((dy) * IMAGE_W + (dx))
+
+// 与 grow_l / grow_r 一一对应的线性偏移，连续写3个周期 (24项)，
+// 这样下标 prev_direction + 7 + k (k = 0..8) 可以直接索引，不需要 & 7 取模
+#define GROW_L_OFFSETS LINEAR_OFFSET(0, -1), LINEAR_OFFSET(1, -1), LINEAR_OFFSET(1, 0), LINEAR_OFFSET(1, 1), \
+                       LINEAR_OFFSET(0, 1), LINEAR_OFFSET(-1, 1), LINEAR_OFFSET(-1, 0), LINEAR_OFFSET(-1, -1)
+#define GROW_R_OFFSETS LINEAR_OFFSET(0, -1), LINEAR_OFFSET(-1, -1), LINEAR_OFFSET(-1, 0), LINEAR_OFFSET(-1, 1), \
+                       LINEAR_OFFSET(0, 1), LINEAR_OFFSET(1, 1), LINEAR_OFFSET(1, 0), LINEAR_OFFSET(1, -1)
+
+static const int16_t grow_l_offset[24] = { GROW_L_OFFSETS, GROW_L_OFFSETS, GROW_L_OFFSETS };
+static const int16_t grow_r_offset[24] = { GROW_R_OFFSETS, GROW_R_OFFSETS, GROW_R_OFFSETS };
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪的通用内核（由左右包装函数分别展开）
+// 参数说明      image         图像数据指针
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 参数说明      table         方向增量表 (grow_l / grow_r)，只在找到新点后更新坐标时使用
+// 参数说明      offsets       对应的24项线性偏移表
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      与 trace_single_step 的探测顺序和判定条件完全相同，区别在于：
+//               1. 每步只计算一次当前点的地址，8次探测都是“基地址 + 常量表偏移”，没有乘法；
+//               2. 偏移表展开为3个周期，方向下标不需要取模；
+//               3. 8次探测手工展开，方向表在编译期确定，不再通过 tracker->grow_table 间接访问。
+// 备注信息      探测点越出图像时，原版按 uint8_t 坐标回绕后寻址，这里按线性偏移寻址，两者读到的都是图像外的无效数据。
+//-------------------------------------------------------------------------------------------------------------------
+static IMAGE_FORCE_INLINE bool trace_step_core(const uint8_t *image, EdgeTracker *tracker,
+                                               const grow *table, const int16_t *offsets)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    const uint8_t threshold = tracker->threshold;
+    const uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+    const uint8_t *center = image + tracker->current_point.y * IMAGE_W + tracker->current_point.x;
+    // off[n] 为方向 (prev_direction + n - 1) 的偏移，第 n 次探测 (对应原循环 i = n - 1) 比较 off[n] 和 off[n + 1]
+    const int16_t *off = offsets + prev_direction + 7;
+    uint8_t k;
+
+#define TRACE_PROBE(n) \
+    if (center[off[n]] < threshold && center[off[(n) + 1]] > threshold) { k = (n) + 1; goto probe_found; }
+
+    TRACE_PROBE(0)
+    TRACE_PROBE(1)
+    TRACE_PROBE(2)
+    TRACE_PROBE(3)
+    TRACE_PROBE(4)
+    TRACE_PROBE(5)
+    TRACE_PROBE(6)
+    TRACE_PROBE(7)
+#undef TRACE_PROBE
+
+    // 8个方向都没找到，边缘中断
+    tracker->is_active = false;
+    return false;
+
+probe_found:
+    {
+        uint8_t new_direction = (prev_direction + 7 + k) & 7;
+        tracker->raw_points_count++;
+        tracker->raw_direction[tracker->raw_points_count] = new_direction;
+        tracker->current_point.x += table[new_direction].x;
+        tracker->current_point.y += table[new_direction].y;
+        tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+        return true;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      左边界专用的单步跟踪
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_left(const uint8_t *image, EdgeTracker *tracker)
+{
+    return trace_step_core(image, tracker, grow_l, grow_l_offset);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      右边界专用的单步跟踪
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_right(const uint8_t *image, EdgeTracker *tracker)
+{
+    return trace_step_core(image, tracker, grow_r, grow_r_offset);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（左右专用跟踪版本）
+// 备注信息      调度策略和终止条件与 search_line 相同；左跟踪器固定使用左边界方向，右跟踪器固定使用右边界方向，
+//               不再读取 tracker->grow_table。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_specialized(const uint8_t* image, EdgeTracker* left_tracker, EdgeTracker* right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_left(image, left_tracker);
+            } else {
+                trace_single_step_right(image, right_tracker);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_left(image, left_tracker);
+        } else if (right_tracker->is_active) {
+            trace_single_step_right(image, right_tracker);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+bool get_start_point(const uint8_t *image, point *p_left, point *p_right); // 实现见 image_processing_01.c
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（左右专用跟踪版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128; // 可以为左右设置不同阈值
+    // 调用函数查找循迹的起始点
+    if (!get_start_point(mt9v03x_image_copy[0], &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return; // 如果找不到起始点，则直接退出本次处理
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 2. 执行阶段 ---
+    search_line_specialized(mt9v03x_image_copy[0], &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 3. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 邻域查表循迹
+// 把当前点的 3x3 二值邻域（去掉中心共8位）拼成一个字节，按“进入方向 + 邻域掩码”查表直接得到下一步方向，
+// 代替 trace_single_step 中最多8对像素的逐个读取和比较。
+// 掩码位序按几何位置固定（与左右方向表无关），左右边界各用一张表：
+//     bit0 bit1 bit2        (x-1,y-1) (x,y-1) (x+1,y-1)
+//     bit3  --  bit4   =    (x-1,y  )   当前   (x+1,y  )
+//     bit5 bit6 bit7        (x-1,y+1) (x,y+1) (x+1,y+1)
+//-------------------------------------------------------------------------------------------------------------------
+#define NEIGHBOUR_LUT_NONE 0xFF // 8个方向都没有 黑→白 跳变
+
+static uint8_t neighbour_lut_l[8][256]; // 左边界：[进入方向][邻域掩码] -> 下一步方向
+static uint8_t neighbour_lut_r[8][256]; // 右边界
+static bool    neighbour_lut_ready = false;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      方向增量在邻域掩码中对应的位号
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t neighbour_mask_bit(const grow *step)
+{
+    uint8_t index = (uint8_t)((step->y + 1) * 3 + (step->x + 1)); // 0..8，4 为中心
+    return (index < 4) ? index : (uint8_t)(index - 1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      按方向表生成一张邻域查找表
+// 参数说明      lut           输出表 [进入方向][邻域掩码]
+// 参数说明      table         方向增量表 (grow_l / grow_r)
+// 备注信息      对每个表项按 trace_single_step 的顺序 (i = -1..6) 检查 dir0 为黑、dir1 为白，结果与逐点探测一致。
+//-------------------------------------------------------------------------------------------------------------------
+static void neighbour_lut_build(uint8_t lut[8][256], const grow *table)
+{
+    uint8_t bit_of_dir[8];
+    for (uint8_t d = 0; d < 8; d++)
+    {
+        bit_of_dir[d] = neighbour_mask_bit(&table[d]);
+    }
+
+    for (uint8_t prev_direction = 0; prev_direction < 8; prev_direction++)
+    {
+        for (uint16_t mask = 0; mask < 256; mask++)
+        {
+            uint8_t next = NEIGHBOUR_LUT_NONE;
+            for (int i = -1; i <= 6; i++)
+            {
+                uint8_t dir0 = (prev_direction + i + 8) & 7;
+                uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+                if (!((mask >> bit_of_dir[dir0]) & 1u) && ((mask >> bit_of_dir[dir1]) & 1u))
+                {
+                    next = dir1;
+                    break;
+                }
+            }
+            lut[prev_direction][mask] = next;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      生成左右两张邻域查找表
+// 备注信息      只需执行一次（可放在 image_init 中），重复调用直接返回。两张表共 4KB，
+//               若 RAM 紧张，可以把生成结果导出成 const 数组放进 Flash。
+//-------------------------------------------------------------------------------------------------------------------
+void neighbour_lut_init(void)
+{
+    if (neighbour_lut_ready)
+    {
+        return;
+    }
+    neighbour_lut_build(neighbour_lut_l, grow_l);
+    neighbour_lut_build(neighbour_lut_r, grow_r);
+    neighbour_lut_ready = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      读取一行中 x-1, x, x+1 三个像素
+// 返回参数      uint32_t      bit0..bit2 依次为 x-1, x, x+1，图像外为黑色(0)
+// 备注信息      与 bin_pixel_checked 相同，利用 uint8_t 回绕，一次无符号比较覆盖上下越界。
+//               每行末字的填充位恒为0，所以右边界外自然读到黑色，只有跨字时需要拼接下一个字。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t packed_triplet(const BinaryFrame *frame, uint8_t x, uint8_t y)
+{
+    if (y >= IMAGE_H)
+    {
+        return 0;
+    }
+    const uint32_t *row = frame->row[y];
+    if (x == 0)
+    {
+        return (row[0] << 1) & 0x6u; // x-1 在图像外
+    }
+
+    uint8_t x0 = x - 1;
+    if (x0 >= IMAGE_W)
+    {
+        return 0;
+    }
+    const uint32_t *word = row + (x0 >> 5);
+    uint8_t shift = x0 & 31;
+    uint32_t bits = word[0] >> shift;
+    if (shift > 29)
+    {
+        bits |= word[1] << (32 - shift);
+    }
+    return bits & 0x7u;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      取当前点的 3x3 邻域掩码（去掉中心，共8位）
+// 备注信息      绝大多数点离图像边界至少1个像素，且3个像素不跨字：此时三行的字下标和移位量相同，
+//               行间距固定为 BIN_ROW_WORDS 个字，直接三次读取拼接；其余情况逐行走带边界检查的 packed_triplet。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint8_t packed_neighbour_mask(const BinaryFrame *frame, point p)
+{
+    uint32_t mask9;
+    uint8_t x0 = p.x - 1;
+    uint8_t shift = x0 & 31;
+
+    if (p.x >= 1 && p.x <= IMAGE_W - 2 && p.y >= 1 && p.y <= IMAGE_H - 2 && shift <= 29)
+    {
+        const uint32_t *word = &frame->row[p.y - 1][x0 >> 5];
+        mask9 = ((word[0] >> shift) & 0x7u)
+              | (((word[BIN_ROW_WORDS] >> shift) & 0x7u) << 3)
+              | (((word[2 * BIN_ROW_WORDS] >> shift) & 0x7u) << 6);
+    }
+    else
+    {
+        mask9 = packed_triplet(frame, p.x, (uint8_t)(p.y - 1))
+              | (packed_triplet(frame, p.x, p.y) << 3)
+              | (packed_triplet(frame, p.x, (uint8_t)(p.y + 1)) << 6);
+    }
+    return (uint8_t)((mask9 & 0x0Fu) | ((mask9 >> 1) & 0xF0u)); // 去掉中心位 bit4
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（邻域查表版本）
+// 参数说明      frame         压缩二值图
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 参数说明      lut           该跟踪器对应的邻域查找表
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      每步固定读3次行数据、查1次表，与 trace_single_step_packed 的结果完全相同；
+//               对灰度图而言，只要像素值不恰好等于阈值，也与 trace_single_step 相同。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_lut(const BinaryFrame *frame, EdgeTracker *tracker, const uint8_t lut[8][256])
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+    uint8_t next = lut[prev_direction][packed_neighbour_mask(frame, tracker->current_point)];
+    if (next == NEIGHBOUR_LUT_NONE)
+    {
+        tracker->is_active = false;
+        return false;
+    }
+
+    tracker->raw_points_count++;
+    tracker->raw_direction[tracker->raw_points_count] = next;
+    tracker->current_point.x += tracker->grow_table[next].x;
+    tracker->current_point.y += tracker->grow_table[next].y;
+    tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（邻域查表版本）
+// 备注信息      调度策略和终止条件与 search_line 相同。调用前需要执行过 neighbour_lut_init。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_lut(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_lut(frame, left_tracker, neighbour_lut_l);
+            } else {
+                trace_single_step_lut(frame, right_tracker, neighbour_lut_r);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_lut(frame, left_tracker, neighbour_lut_l);
+        } else if (right_tracker->is_active) {
+            trace_single_step_lut(frame, right_tracker, neighbour_lut_r);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 5 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 5) {
+                break;
+            }
+        }
+    }
+}
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（邻域查表循迹版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      二值化压缩、起点搜索沿用压缩帧版本 (binarize_and_pack / get_start_point_packed)，只替换循迹部分。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+    neighbour_lut_init(); // 仅第一次调用时生成查找表
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_lut(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,463 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      带边界检查的像素读取，图像外一律视为黑色
+// 备注信息      坐标为 uint8_t，越过左/上边界时会回绕成很大的值，因此一次无符号比较即可覆盖四个方向。
+//               灰度版循迹依赖黑边框，越界读取的是相邻内存；压缩帧按字存储，越界会读到其他行甚至帧外，必须拦截。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t bin_pixel_checked(const BinaryFrame *frame, uint8_t x, uint8_t y)
+{
+    if (x >= IMAGE_W || y >= IMAGE_H)
+    {
+        return 0;
+    }
+    return BIN_PIXEL(frame, x, y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（压缩二值图版本）
+// 参数说明      frame         压缩二值图
+// 参数说明      tracker       需要进行单步推进的边缘跟踪器
+// 返回参数      bool          成功找到下一点则返回true，否则返回false
+// 备注信息      搜索顺序与 trace_single_step 完全相同，只是把两次灰度读取和阈值比较换成了两次位读取。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_packed(const BinaryFrame *frame, EdgeTracker *tracker)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        uint8_t a0_x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        uint8_t a0_y = tracker->current_point.y + tracker->grow_table[dir0].y;
+        uint8_t a1_x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        uint8_t a1_y = tracker->current_point.y + tracker->grow_table[dir1].y;
+
+        // 黑 → 白 跳变
+        if (!bin_pixel_checked(frame, a0_x, a0_y) && bin_pixel_checked(frame, a1_x, a1_y))
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point.x += tracker->grow_table[dir1].x;
+            tracker->current_point.y += tracker->grow_table[dir1].y;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 直线段“跳跃”加速
+// 当跟踪器最近 GALLOP_MIN_RUN 步方向都相同 (记为 d) 时，单步跟踪下一步的第一次探测 (dir0 = d-1 为黑、dir1 = d 为白)
+// 大概率仍然成立，而第一次探测成立时单步跟踪必然选择方向 d。因此可以沿 d 直接向前推进多步，
+// 每步只校验这一对像素，成立即写入，不成立就停下，剩下的交回单步跟踪。回填结果与逐步跟踪完全一致。
+// 水平段的黑、白探测点分别落在同一行的连续像素上，可以用两次取位一次校验全部步。
+//
+// search_line 每次只推进 y 更大的一侧，两侧同时向上走时几乎每步都要换边，直接在调度里跳跃最多只能跳1~2步。
+// 因此这里把“跟踪”和“调度”分开：每条边各自向前跟踪（允许超前），调度循环照搬 search_line 的规则，
+// 只在已跟踪好的点上逐个确认，确认到跟踪前沿时才继续跟踪。单边的跟踪结果与调度无关，
+// 所以最终确认的点数、交汇退出、迭代次数都与 search_line 一致，超前跟踪的点只是被丢弃。
+//-------------------------------------------------------------------------------------------------------------------
+#define GALLOP_MIN_RUN   3  // 连续相同方向达到该步数后才尝试跳跃
+#define GALLOP_MIN_STEPS 2  // 可跳步数少于该值时直接单步
+#define GALLOP_MAX_STEPS 16 // 单次最多跳跃的步数 (水平段按位掩码校验，不能超过 32)
+
+typedef struct {
+    uint32_t loop_iterations; // 调度循环次数，与 search_line 的循环次数相同
+    uint32_t trace_calls;     // 实际执行的跟踪次数（单步 + 成功的跳跃）
+    uint32_t gallop_hits;     // 成功跳跃的次数
+    uint32_t gallop_misses;   // 校验失败、退回单步的次数
+    uint32_t gallop_points;   // 通过跳跃得到的边缘点数
+} GallopStats;
+
+static GallopStats gallop_stats; // 最近一帧的跳跃统计
+
+static inline uint8_t clz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_clz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 0x80000000u)) { v <<= 1; n++; }
+    return n;
+#endif
+}
+
+static inline uint8_t ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      取压缩行中从 x 开始的连续 n 个像素
+// 返回参数      uint32_t      bit k 对应像素 (x + k, y)
+// 备注信息      调用方保证 n <= 32 且整段都在图像内。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t packed_row_bits(const BinaryFrame *frame, int16_t y, int16_t x, uint8_t n)
+{
+    const uint32_t *word = &frame->row[y][x >> 5];
+    uint8_t shift = x & 31;
+    uint32_t bits = word[0] >> shift;
+    if (shift + n > 32)
+    {
+        bits |= word[1] << (32 - shift);
+    }
+    return (n >= 32) ? bits : (bits & ((1u << n) - 1u));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      沿一个坐标轴，从 v 出发每步走 dv，起点保持在 [1, hi] 内的步数
+// 备注信息      起点距图像边界至少1个像素时，它的8个探测点都在图像内，可以不做边界检查。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint16_t gallop_room(int16_t v, int8_t dv, int16_t hi)
+{
+    if (v < 1 || v > hi) {
+        return 0;
+    }
+    if (dv > 0) {
+        return (uint16_t)(hi - v + 1);
+    }
+    if (dv < 0) {
+        return (uint16_t)v;
+    }
+    return GALLOP_MAX_STEPS;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      沿当前直线方向尝试一次多步跳跃
+// 参数说明      frame         压缩二值图
+// 参数说明      tracker       需要推进的边缘跟踪器
+// 返回参数      uint16_t      实际推进的步数，0 表示未跳跃，需要调用方执行一次单步
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t trace_gallop_packed(const BinaryFrame *frame, EdgeTracker *tracker)
+{
+    const uint16_t count = tracker->raw_points_count;
+    if (count < GALLOP_MIN_RUN) {
+        return 0;
+    }
+
+    const uint8_t d = tracker->raw_direction[count];
+    for (uint8_t k = 1; k < GALLOP_MIN_RUN; k++)
+    {
+        if (tracker->raw_direction[count - k] != d) {
+            return 0;
+        }
+    }
+
+    const grow g  = tracker->grow_table[d];           // 前进方向，也是第一次探测的 dir1 (应为白)
+    const grow g0 = tracker->grow_table[(d + 7) & 7]; // 第一次探测的 dir0 (应为黑)
+    point q = tracker->current_point;
+
+    // --- 1. 本次最多能走的步数：缓冲区上限、单次上限、探测点不越出图像 ---
+    uint16_t limit = MAX_EDGE_POINTS - 1 - count;
+    if (limit > GALLOP_MAX_STEPS) {
+        limit = GALLOP_MAX_STEPS;
+    }
+    uint16_t room = gallop_room(q.x, g.x, IMAGE_W - 2);
+    if (limit > room) {
+        limit = room;
+    }
+    room = gallop_room(q.y, g.y, IMAGE_H - 2);
+    if (limit > room) {
+        limit = room;
+    }
+    if (limit < GALLOP_MIN_STEPS) {
+        return 0;
+    }
+
+    // --- 2. 校验：第 m 步的探测对位于 q + m*g + g0 (应为黑) 和 q + (m+1)*g (应为白) ---
+    uint16_t steps;
+    if (g.y == 0)
+    {
+        // 水平段：左右方向表中水平方向的前一方向都满足 g0.x == g.x，黑、白两行覆盖的列区间相同
+        int16_t x_lo = (g.x > 0) ? q.x + 1 : q.x - (int16_t)limit;
+        uint32_t ok = ~packed_row_bits(frame, q.y + g0.y, x_lo, (uint8_t)limit)
+                    &  packed_row_bits(frame, q.y, x_lo, (uint8_t)limit)
+                    & ((1u << limit) - 1u);
+        steps = (g.x > 0) ? ctz32(~ok) : clz32(~(ok << (32 - limit)));
+    }
+    else
+    {
+        int16_t x = q.x, y = q.y;
+        for (steps = 0; steps < limit; steps++)
+        {
+            if (BIN_PIXEL(frame, x + g0.x, y + g0.y) || !BIN_PIXEL(frame, x + g.x, y + g.y)) {
+                break;
+            }
+            x += g.x;
+            y += g.y;
+        }
+    }
+
+    if (steps == 0) {
+        gallop_stats.gallop_misses++;
+        return 0;
+    }
+
+    // --- 3. 回填：方向全部为 d ---
+    for (uint16_t m = 1; m <= steps; m++)
+    {
+        q.x += g.x;
+        q.y += g.y;
+        tracker->raw_direction[count + m] = d;
+        tracker->raw_edge_points[count + m] = q;
+    }
+    tracker->raw_points_count += steps;
+    tracker->current_point = q;
+
+    gallop_stats.gallop_hits++;
+    gallop_stats.gallop_points += steps;
+    return steps;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      按调度确认跟踪器的下一个点，必要时继续向前跟踪
+// 参数说明      frame         压缩二值图
+// 参数说明      tracker       被调度选中的跟踪器
+// 参数说明      used          该跟踪器已确认的点数（最后一个已确认点的下标）
+// 备注信息      跟踪失败时 trace_single_step_packed 会把 is_active 置为 false，
+//               失败只会发生在“已确认到跟踪前沿”时，与 search_line 中该侧停止的时机相同。
+//-------------------------------------------------------------------------------------------------------------------
+static void gallop_advance(const BinaryFrame *frame, EdgeTracker *tracker, uint16_t *used)
+{
+    if (*used == tracker->raw_points_count)
+    {
+        gallop_stats.trace_calls++;
+        if (trace_gallop_packed(frame, tracker) == 0 && !trace_single_step_packed(frame, tracker)) {
+            return;
+        }
+    }
+    (*used)++;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（直线段跳跃版本）
+// 参数说明      frame         压缩二值图
+// 参数说明      left_tracker  左跟踪器
+// 参数说明      right_tracker 右跟踪器
+// 参数说明      max_iterations 最大迭代次数
+// 备注信息      调度策略和终止条件与 search_line 相同，输出的边缘点列表与 search_line_packed 完全一致。
+//               调度和交汇判断使用“已确认的最后一个点”，结束时把 raw_points_count / current_point 回退到已确认位置。
+//-------------------------------------------------------------------------------------------------------------------
+void search_line_gallop(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    memset(&gallop_stats, 0, sizeof(gallop_stats));
+
+    uint16_t left_used = 0;  // 左边已确认的点
+    uint16_t right_used = 0; // 右边已确认的点
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        gallop_stats.loop_iterations++;
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->raw_edge_points[left_used].y >= right_tracker->raw_edge_points[right_used].y) {
+                gallop_advance(frame, left_tracker, &left_used);
+            } else {
+                gallop_advance(frame, right_tracker, &right_used);
+            }
+        } else if (left_tracker->is_active) {
+            gallop_advance(frame, left_tracker, &left_used);
+        } else if (right_tracker->is_active) {
+            gallop_advance(frame, right_tracker, &right_used);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            point l = left_tracker->raw_edge_points[left_used];
+            point r = right_tracker->raw_edge_points[right_used];
+            if (abs(l.x - r.x) < 5 && abs(l.y - r.y) < 5) {
+                break;
+            }
+        }
+    }
+
+    // 丢弃超前跟踪的部分
+    left_tracker->raw_points_count = left_used;
+    left_tracker->current_point = left_tracker->raw_edge_points[left_used];
+    right_tracker->raw_points_count = right_used;
+    right_tracker->current_point = right_tracker->raw_edge_points[right_used];
+}
+
+void extract_and_filter_edges(TrackContext *context); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（直线段跳跃版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      二值化压缩、起点搜索沿用压缩帧版本；循迹结果与 search_line_packed 相同，
+//               gallop_stats.trace_calls 与 loop_iterations 对比可以看出直道上实际跟踪次数的下降。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_gallop(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段：从起点行开始提纯，行地图转换在 extract_and_filter_edges 内完成 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    extract_and_filter_edges(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
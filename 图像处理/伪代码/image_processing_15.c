@@ -0,0 +1,393 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 游程 (RLE) 行表示
+// 把压缩二值图的每一行转换为白色游程列表 [start, end]，之后不再逐像素探测邻域：
+// 从起始行的赛道游程开始逐行向上，取与当前区间 8 邻接（区间重叠或对角相接）的所有游程，
+// 其最左端、最右端即为该行的左、右边界，直接写入 mapped_edge，不需要 search_line 和
+// convert_edge_to_row_map_first_point。
+//-------------------------------------------------------------------------------------------------------------------
+#ifndef EDGE_ENGINE_RUNS
+#define EDGE_ENGINE_RUNS 1   // 1: 游程引擎；0: 轮廓跟踪 (search_line_packed)
+#endif
+#define RLE_MAX_RUNS     24  // 每行最多记录的游程数，超出的部分丢弃并计数
+
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u // 可映射到 DWT->CYCCNT 以统计耗时
+#endif
+
+typedef struct {
+    uint8_t start; // 游程第一个白像素的 x
+    uint8_t end;   // 游程最后一个白像素的 x
+} WhiteRun;
+
+typedef struct {
+    WhiteRun run[IMAGE_H][RLE_MAX_RUNS]; // 每行的白色游程，按 x 递增
+    uint8_t  count[IMAGE_H];             // 每行的游程数
+    uint16_t dropped_runs;               // 因超出 RLE_MAX_RUNS 被丢弃的游程数
+} RunFrame;
+
+typedef struct {
+    uint32_t encode_cycles; // 游程编码耗时 (周期)
+    uint32_t scan_cycles;   // 逐行连通扫描耗时 (周期)
+    uint16_t total_runs;    // 本帧游程总数
+    uint8_t  rows_scanned;  // 写入行地图的行数
+} RunEngineStats;
+
+static RunFrame run_frame;             // 本帧的游程表
+static RunEngineStats run_engine_stats; // 最近一帧的统计
+
+static inline uint8_t ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把压缩二值图的一行转换为白色游程列表
+// 参数说明      row           压缩行 (BIN_ROW_WORDS 个字)
+// 参数说明      runs          输出游程数组，容量 RLE_MAX_RUNS
+// 参数说明      dropped       累加被丢弃的游程数
+// 返回参数      uint8_t       写入的游程数
+// 备注信息      每个字用两次移位求出游程起点 (本位为1、左邻为0) 和终点 (本位为1、右邻为0) 的位掩码，
+//               跨字时拼接相邻字的边界位；再按 x 顺序交替弹出起点/终点，一个字只需要“游程数 × 2”次 ctz。
+//               末字的填充位恒为0，最后一个游程一定会在行内结束。
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t packed_row_to_runs(const uint32_t *row, WhiteRun *runs, uint16_t *dropped)
+{
+    uint8_t n = 0;
+    uint8_t start = 0;
+    bool open = false;
+    uint32_t carry = 0; // 上一个字的最高位
+
+    for (int i = 0; i < BIN_ROW_WORDS; i++)
+    {
+        uint32_t w = row[i];
+        uint32_t next = (i + 1 < BIN_ROW_WORDS) ? (row[i + 1] & 1u) : 0;
+        uint32_t starts = w & ~((w << 1) | carry);
+        uint32_t ends   = w & ~((w >> 1) | (next << 31));
+        uint8_t base = (uint8_t)(i * 32);
+        carry = w >> 31;
+
+        while (starts | ends)
+        {
+            if (!open)
+            {
+                start = base + ctz32(starts);
+                starts &= starts - 1;
+                open = true;
+            }
+            else
+            {
+                uint8_t end = base + ctz32(ends);
+                ends &= ends - 1;
+                open = false;
+                if (n < RLE_MAX_RUNS)
+                {
+                    runs[n].start = start;
+                    runs[n].end = end;
+                    n++;
+                }
+                else
+                {
+                    (*dropped)++;
+                }
+            }
+        }
+    }
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      整帧游程编码
+// 参数说明      frame         压缩二值图
+// 参数说明      runs          输出的游程表
+//-------------------------------------------------------------------------------------------------------------------
+void rle_encode_frame(const BinaryFrame *frame, RunFrame *runs)
+{
+    runs->dropped_runs = 0;
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        runs->count[y] = packed_row_to_runs(frame->row[y], runs->run[y], &runs->dropped_runs);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在一行的游程中求与区间 [left, right] 8 邻接的所有游程的最左、最右端
+// 参数说明      runs / count  该行的游程
+// 参数说明      left / right  输入为下一行的区间，输出为本行的区间
+// 返回参数      bool          存在邻接游程返回true
+// 备注信息      8 邻接：游程与 [left - 1, right + 1] 有交集。游程按 x 递增，越过 right + 1 即可停止。
+//-------------------------------------------------------------------------------------------------------------------
+static bool runs_connected_span(const WhiteRun *runs, uint8_t count, uint8_t *left, uint8_t *right)
+{
+    int16_t lo = (int16_t)*left - 1;
+    int16_t hi = (int16_t)*right + 1;
+    bool found = false;
+    uint8_t new_left = 0, new_right = 0;
+
+    for (uint8_t k = 0; k < count; k++)
+    {
+        if (runs[k].start > hi)
+        {
+            break;
+        }
+        if (runs[k].end >= lo)
+        {
+            if (!found)
+            {
+                new_left = runs[k].start;
+                found = true;
+            }
+            new_right = runs[k].end;
+        }
+    }
+
+    if (found)
+    {
+        *left = new_left;
+        *right = new_right;
+    }
+    return found;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      用游程表直接生成左右边界的行地图
+// 参数说明      runs          本帧的游程表
+// 参数说明      context       输出 left_edge / right_edge 的 mapped_edge、mapped_edge_start_y、mapped_edge_end_y
+// 返回参数      bool          起始行找到赛道游程返回true
+// 备注信息      起始行与种子区间沿用 get_start_point_packed 的结果：start_point.x 分别是“黑黑白白”“白白黑黑”模式的起点，
+//               区间 [左起点, 右起点 + 1] 内的白像素就是赛道。之后每一行只保留与下一行区间 8 邻接的游程，
+//               直到某一行没有邻接游程为止。左边界取区间最左的白像素，右边界取最右的白像素，
+//               与轮廓跟踪在该行记录的点（紧贴黑色的白像素）定义相同。
+// 备注信息      未写入的行保持为0，与 convert_edge_to_row_map_first_point 的约定一致。
+//-------------------------------------------------------------------------------------------------------------------
+bool build_row_maps_from_runs(const RunFrame *runs, TrackContext *context)
+{
+    EdgeTracker *left_edge = &context->left_edge;
+    EdgeTracker *right_edge = &context->right_edge;
+    uint8_t y = left_edge->start_point.y;
+    uint8_t left = left_edge->start_point.x;
+    uint8_t right = right_edge->start_point.x + 1;
+
+    memset(left_edge->mapped_edge, 0, IMAGE_H);
+    memset(right_edge->mapped_edge, 0, IMAGE_H);
+    run_engine_stats.rows_scanned = 0;
+
+    // 1. 起始行：取与种子区间相交的游程
+    if (y >= IMAGE_H || !runs_connected_span(runs->run[y], runs->count[y], &left, &right))
+    {
+        left_edge->mapped_edge_start_y = right_edge->mapped_edge_start_y = y;
+        left_edge->mapped_edge_end_y = right_edge->mapped_edge_end_y = IMAGE_H;
+        return false;
+    }
+    left_edge->mapped_edge_start_y = right_edge->mapped_edge_start_y = y;
+
+    // 2. 逐行向上
+    while (true)
+    {
+        left_edge->mapped_edge[y] = left;
+        right_edge->mapped_edge[y] = right;
+        run_engine_stats.rows_scanned++;
+
+        if (y <= 1 || !runs_connected_span(runs->run[y - 1], runs->count[y - 1], &left, &right))
+        {
+            break;
+        }
+        y--;
+    }
+
+    left_edge->mapped_edge_end_y = right_edge->mapped_edge_end_y = y;
+    return true;
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（游程引擎版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      EDGE_ENGINE_RUNS 为0时走轮廓跟踪 (search_line_packed + 行地图转换)，两种引擎输出相同格式的行地图，
+//               之后统一交给 extract_and_filter_edges_fused 做边缘提纯和有效距离计算。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+
+#if EDGE_ENGINE_RUNS
+    // --- 3. 游程编码 + 逐行连通扫描，直接得到行地图 ---
+    uint32_t t0 = IMAGE_CYCLE_COUNTER();
+    rle_encode_frame(&binary_frame, &run_frame);
+    uint32_t t1 = IMAGE_CYCLE_COUNTER();
+    bool found = build_row_maps_from_runs(&run_frame, context);
+    uint32_t t2 = IMAGE_CYCLE_COUNTER();
+
+    run_engine_stats.encode_cycles = t1 - t0;
+    run_engine_stats.scan_cycles = t2 - t1;
+    run_engine_stats.total_runs = 0;
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        run_engine_stats.total_runs += run_frame.count[y];
+    }
+    if (!found) {
+        return;
+    }
+#else
+    // --- 3. 轮廓跟踪 + 行地图转换 ---
+    // 游程引擎直接用 get_start_point_packed 的模式起点作种子区间，只有轮廓跟踪需要把起点移到跟踪器的出发点
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+#endif
+
+    // --- 4. 结果处理阶段 ---
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,511 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+// 白色游程与整帧游程表，格式与 rle_encode_frame 的输出一致
+#define RLE_MAX_RUNS 24
+
+typedef struct {
+    uint8_t start; // 游程第一个白像素的 x
+    uint8_t end;   // 游程最后一个白像素的 x
+} WhiteRun;
+
+typedef struct {
+    WhiteRun run[IMAGE_H][RLE_MAX_RUNS];
+    uint8_t  count[IMAGE_H];
+    uint16_t dropped_runs;
+} RunFrame;
+
+static RunFrame run_frame; // 本帧的游程表
+
+//-------------------------------------------------------------------------------------------------------------------
+// 基于游程的连通域标记
+// 起点搜索只认第一个宽度大于 10 的“黑黑白白/白白黑黑”组合，底部的噪声白块同样可能满足条件，
+// 选错起点后整个 search_line 都是白跑。这里对游程做一遍连通域标记，取接触底部若干行、面积最大的白色连通域作为赛道，
+// 再用它在最低一行的左右端生成起点。
+// 说明:
+// 1. 从最下面一行向上逐行扫描，每个游程只和下一行的游程比较 (8 邻接)，等价关系用并查集记录，全程只扫描一遍游程表。
+// 2. 标签表、下一行/当前行的标签都是固定大小的静态数组，不做动态分配。标签用尽时先回收已经结束且不接触底部的
+//    连通域的标签，仍然不够时新出现的连通域不再编号，这些游程计入 overflow_runs 并被忽略。
+// 3. 自下而上扫描时底部区域最先编号，其游程数最多 (CCL_BOTTOM_ROWS + 1) * RLE_MAX_RUNS，小于标签数上限，
+//    所以候选连通域在底部的游程一定有标签，起点不受标签用尽影响；上方的噪声块结束后标签即被回收，
+//    只有同一时刻仍在生长的连通域超过上限时，以后才并入赛道的分支会少计一部分面积。
+// 4. 面积、外接矩形先记在临时标签上，扫描结束后再按并查集的根合并。
+//-------------------------------------------------------------------------------------------------------------------
+#define CCL_MAX_LABELS  256 // 临时标签数上限 (0 号保留为“无标签”)
+#define CCL_BOTTOM_ROWS 8   // “接触底部”的判定范围：第 IMAGE_H - 2 行起向上 CCL_BOTTOM_ROWS 行
+#define CCL_BOTTOM_Y    (IMAGE_H - 1 - CCL_BOTTOM_ROWS) // 底部区域的最上一行
+
+#if (CCL_BOTTOM_ROWS + 1) * RLE_MAX_RUNS >= CCL_MAX_LABELS
+#error "底部区域的游程数可能超过标签数，起点所在的连通域会拿不到标签"
+#endif
+
+typedef struct {
+    uint16_t parent;   // 并查集父节点，根节点指向自身
+    uint16_t area;     // 白像素个数
+    uint8_t  x_min;    // 外接矩形
+    uint8_t  y_min;
+    uint8_t  x_max;
+    uint8_t  y_max;
+    bool     touches_bottom; // 是否有游程落在底部区域
+} CclLabel;
+
+typedef struct {
+    bool     found;       // 是否找到接触底部的连通域
+    uint16_t area;        // 面积 (像素)
+    uint8_t  x_min;       // 外接矩形
+    uint8_t  y_min;
+    uint8_t  x_max;
+    uint8_t  y_max;
+    uint16_t label_count; // 本帧分配临时标签的次数 (含回收后再分配的)
+    uint16_t overflow_runs; // 因标签用尽而未标记的游程数
+} TrackComponent;
+
+static CclLabel ccl_label[CCL_MAX_LABELS]; // parent 为 0 表示该标签空闲
+static uint16_t ccl_free_label[CCL_MAX_LABELS]; // 已回收、可以重新分配的标签
+static uint16_t ccl_free_count;
+static uint16_t ccl_bottom_label[CCL_BOTTOM_ROWS][RLE_MAX_RUNS]; // 底部区域各游程的临时标签，用于生成起点
+static TrackComponent track_component; // 最近一帧的赛道连通域
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      并查集查找根节点 (路径减半)
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t ccl_find(uint16_t label)
+{
+    while (ccl_label[label].parent != label)
+    {
+        ccl_label[label].parent = ccl_label[ccl_label[label].parent].parent;
+        label = ccl_label[label].parent;
+    }
+    return label;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      合并两个等价类，返回合并后的根
+// 备注信息      总是以编号较小的根为新根，合并结果与游程的处理顺序无关。
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t ccl_union(uint16_t a, uint16_t b)
+{
+    a = ccl_find(a);
+    b = ccl_find(b);
+    if (a == b)
+    {
+        return a;
+    }
+    if (a < b)
+    {
+        ccl_label[b].parent = a;
+        return a;
+    }
+    ccl_label[a].parent = b;
+    return b;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      回收已经结束且不接触底部的连通域的标签
+// 参数说明      below         下一行各游程的标签
+// 参数说明      below_count   下一行的游程数
+// 参数说明      cur           当前行已处理游程的标签
+// 参数说明      cur_count     当前行已处理的游程数
+// 参数说明      label_end     分配过的最大标签 + 1
+// 备注信息      自下而上扫描时，在下一行和当前行都没有游程的连通域不会再长大，也不会再与别的连通域合并；
+//               其中不接触底部的不可能成为赛道，统计可以丢弃，它的全部标签放回空闲表。
+// 备注信息      先把每个标签的父节点直接指向根，之后释放某个标签不会切断其他标签到根的路径。
+//-------------------------------------------------------------------------------------------------------------------
+static void ccl_recycle(const uint16_t *below, uint8_t below_count, const uint16_t *cur, uint8_t cur_count, uint16_t label_end)
+{
+    static bool keep[CCL_MAX_LABELS];
+
+    memset(keep, 0, label_end * sizeof(bool));
+    for (uint16_t label = 1; label < label_end; label++)
+    {
+        if (ccl_label[label].parent != 0)
+        {
+            ccl_label[label].parent = ccl_find(label);
+        }
+    }
+    for (uint8_t k = 0; k < below_count; k++)
+    {
+        keep[ccl_label[below[k]].parent] = true; // 未标记的游程为 0 号，0 号的 parent 为 0，不影响结果
+    }
+    for (uint8_t k = 0; k < cur_count; k++)
+    {
+        keep[ccl_label[cur[k]].parent] = true;
+    }
+    for (uint16_t label = 1; label < label_end; label++)
+    {
+        if (ccl_label[label].parent != 0 && ccl_label[label].touches_bottom)
+        {
+            keep[ccl_label[label].parent] = true;
+        }
+    }
+
+    for (uint16_t label = 1; label < label_end; label++)
+    {
+        if (ccl_label[label].parent != 0 && !keep[ccl_label[label].parent])
+        {
+            ccl_label[label].parent = 0;
+            ccl_free_label[ccl_free_count++] = label;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把一个游程计入标签的面积与外接矩形
+//-------------------------------------------------------------------------------------------------------------------
+static void ccl_accumulate(CclLabel *label, const WhiteRun *run, uint8_t y)
+{
+    label->area += run->end - run->start + 1;
+    if (run->start < label->x_min) label->x_min = run->start;
+    if (run->end > label->x_max)   label->x_max = run->end;
+    if (y < label->y_min)          label->y_min = y;
+    if (y > label->y_max)          label->y_max = y;
+    if (y >= CCL_BOTTOM_Y && y <= IMAGE_H - 2)
+    {
+        label->touches_bottom = true;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      对整帧游程做连通域标记，找出接触底部且面积最大的白色连通域
+// 参数说明      runs          本帧的游程表 (rle_encode_frame 的输出)
+// 参数说明      component     输出连通域的面积、外接矩形和标签使用情况
+// 返回参数      uint16_t      该连通域的根标签，没有找到返回0
+// 备注信息      当前行与下一行的游程都按 x 递增，用双指针比较：下一行中 end + 1 < start 的游程
+//               不会再和当前行之后的游程相连，可以直接跳过。
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t ccl_label_runs(const RunFrame *runs, TrackComponent *component)
+{
+    uint16_t below_label[RLE_MAX_RUNS];
+    uint16_t cur_label[RLE_MAX_RUNS];
+    uint8_t below_count = 0;
+    uint16_t next_label = 1;
+    int16_t recycled_y = IMAGE_H; // 每行最多回收一次，标签确实不够时不反复遍历标签表
+
+    ccl_label[0].parent = 0;
+    ccl_free_count = 0;
+    component->label_count = 0;
+    component->overflow_runs = 0;
+
+    for (int16_t y = IMAGE_H - 1; y >= 0; y--)
+    {
+        const WhiteRun *cur = runs->run[y];
+        const WhiteRun *below = (y < IMAGE_H - 1) ? runs->run[y + 1] : NULL;
+        uint8_t cur_count = runs->count[y];
+        uint8_t i = 0;
+
+        for (uint8_t j = 0; j < cur_count; j++)
+        {
+            uint16_t label = 0;
+
+            // 1. 与下一行 8 邻接的游程：区间 [start - 1, end + 1] 有交集
+            while (i < below_count && below[i].end + 1 < cur[j].start)
+            {
+                i++;
+            }
+            for (uint8_t k = i; k < below_count && below[k].start <= cur[j].end + 1; k++)
+            {
+                if (below_label[k] == 0)
+                {
+                    continue; // 下一行中未标记的游程
+                }
+                label = (label == 0) ? ccl_find(below_label[k]) : ccl_union(label, below_label[k]);
+            }
+
+            // 2. 没有相连的游程则分配新标签，标签用尽时先回收
+            if (label == 0 && ccl_free_count == 0 && next_label == CCL_MAX_LABELS && recycled_y != y)
+            {
+                ccl_recycle(below_label, below_count, cur_label, j, next_label);
+                recycled_y = y;
+            }
+            if (label == 0 && (ccl_free_count > 0 || next_label < CCL_MAX_LABELS))
+            {
+                label = (ccl_free_count > 0) ? ccl_free_label[--ccl_free_count] : next_label++;
+                component->label_count++;
+                ccl_label[label].parent = label;
+                ccl_label[label].area = 0;
+                ccl_label[label].x_min = IMAGE_W;
+                ccl_label[label].x_max = 0;
+                ccl_label[label].y_min = IMAGE_H;
+                ccl_label[label].y_max = 0;
+                ccl_label[label].touches_bottom = false;
+            }
+
+            if (label == 0)
+            {
+                component->overflow_runs++;
+            }
+            else
+            {
+                ccl_accumulate(&ccl_label[label], &cur[j], (uint8_t)y);
+            }
+
+            cur_label[j] = label;
+            if (y >= CCL_BOTTOM_Y && y <= IMAGE_H - 2)
+            {
+                ccl_bottom_label[y - CCL_BOTTOM_Y][j] = label;
+            }
+        }
+
+        memcpy(below_label, cur_label, cur_count * sizeof(uint16_t));
+        below_count = cur_count;
+    }
+
+    // 3. 把临时标签的统计合并到各自的根上 (ccl_find 直接返回最终的根，遍历一次即可)
+    for (uint16_t label = next_label - 1; label > 0; label--)
+    {
+        if (ccl_label[label].parent == 0)
+        {
+            continue; // 已回收且未再分配的标签
+        }
+        uint16_t root = ccl_find(label);
+        if (root == label)
+        {
+            continue;
+        }
+        CclLabel *r = &ccl_label[root];
+        const CclLabel *l = &ccl_label[label];
+        r->area += l->area;
+        if (l->x_min < r->x_min) r->x_min = l->x_min;
+        if (l->x_max > r->x_max) r->x_max = l->x_max;
+        if (l->y_min < r->y_min) r->y_min = l->y_min;
+        if (l->y_max > r->y_max) r->y_max = l->y_max;
+        r->touches_bottom |= l->touches_bottom;
+    }
+
+    // 4. 选出接触底部且面积最大的连通域
+    uint16_t best = 0;
+    for (uint16_t label = 1; label < next_label; label++)
+    {
+        if (ccl_label[label].parent == label && ccl_label[label].touches_bottom &&
+            (best == 0 || ccl_label[label].area > ccl_label[best].area))
+        {
+            best = label;
+        }
+    }
+
+    component->found = (best != 0);
+    if (best != 0)
+    {
+        component->area = ccl_label[best].area;
+        component->x_min = ccl_label[best].x_min;
+        component->y_min = ccl_label[best].y_min;
+        component->x_max = ccl_label[best].x_max;
+        component->y_max = ccl_label[best].y_max;
+    }
+    return best;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      用赛道连通域生成左右边界的起始点
+// 参数说明      runs          本帧的游程表
+// 参数说明      p_left        用于存储左边界起点坐标的指针 (point *)
+// 参数说明      p_right       用于存储右边界起点坐标的指针 (point *)
+// 返回参数      bool          找到赛道连通域且起始行宽度大于 10 时返回true
+// 备注信息      从底部区域最下面一行开始，取第一行含有该连通域游程的行作为起始行，
+//               该行中属于它的最左、最右游程端点就是赛道左右边界。
+// 备注信息      输出坐标与 get_start_point_packed 的约定相同：左起点是“黑黑白白”中第一个黑像素 (白像素紧贴图像左缘时为 1)，
+//               右起点是“白白黑黑”中第一个白像素 (紧贴右缘时为 IMAGE_W - 2)，可以直接替换原来的起点搜索。
+//-------------------------------------------------------------------------------------------------------------------
+bool get_start_point_ccl(const RunFrame *runs, point *p_left, point *p_right)
+{
+    uint16_t best = ccl_label_runs(runs, &track_component);
+    if (best == 0)
+    {
+        return false;
+    }
+
+    for (int y = IMAGE_H - 2; y >= CCL_BOTTOM_Y; y--)
+    {
+        const WhiteRun *row = runs->run[y];
+        int16_t left = -1;
+        int16_t right = -1;
+
+        for (uint8_t j = 0; j < runs->count[y]; j++)
+        {
+            uint16_t label = ccl_bottom_label[y - CCL_BOTTOM_Y][j];
+            if (label == 0 || ccl_find(label) != best)
+            {
+                continue;
+            }
+            if (left < 0)
+            {
+                left = row[j].start;
+            }
+            right = row[j].end;
+        }
+        if (left < 0)
+        {
+            continue;
+        }
+
+        p_left->x = (left <= 1) ? 1 : (uint8_t)(left - 2);
+        p_left->y = (uint8_t)y;
+        p_right->x = (right >= IMAGE_W - 2) ? IMAGE_W - 2 : (uint8_t)(right - 1);
+        p_right->y = (uint8_t)y;
+        return (p_right->x - p_left->x) > 10;
+    }
+    return false;
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+void rle_encode_frame(const BinaryFrame *frame, RunFrame *runs); // 实现见 image_processing_15.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（连通域起点版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      起点改由赛道连通域生成，底部的噪声白块面积小，不会再被当作起点。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 + 游程编码 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+    rle_encode_frame(&binary_frame, &run_frame);
+
+    if (!get_start_point_ccl(&run_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 压缩二值图上的位运算形态学
+// 二值化后的椒盐噪声会一直传到轮廓跟踪，extract_single_edge 只能靠 MIN_VALID_SEGMENT_LENGTH 和
+// MAX_EDGE_HORIZONTAL_JUMP 事后剔除，经常提前 goto extraction_finished 截断边缘。这里在跟踪之前做一次 3x3 开/闭运算：
+// 1. 一行 188 个像素只有 6 个字。水平方向的 3 邻域由字的左右移位 (拼接相邻字的边界位) 与本字做与/或得到，
+//    垂直方向再对相邻三行的水平结果做与/或，整帧一次 3x3 腐蚀或膨胀约 720 个字、每字十来次位运算。
+// 2. 原地处理：只缓存上一行、当前行、下一行的水平结果 (3 x 6 个字)，不需要第二帧缓冲。
+// 3. 图像外的像素按该运算的单位元处理 (腐蚀视为白、膨胀视为黑)，开/闭运算不会把紧贴图像边缘的赛道削掉。
+//-------------------------------------------------------------------------------------------------------------------
+typedef enum {
+    MORPH_NONE = 0,   // 不处理
+    MORPH_OPEN,       // 开运算 (先腐蚀后膨胀)：去掉黑色背景上的孤立白点
+    MORPH_CLOSE,      // 闭运算 (先膨胀后腐蚀)：填上赛道内部的孤立黑点
+    MORPH_OPEN_CLOSE  // 先开后闭：两种噪声都去掉
+} MorphMode;
+
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u // 可映射到 DWT->CYCCNT 以统计耗时
+#endif
+
+static MorphMode morph_mode = MORPH_OPEN_CLOSE; // 每帧可单独修改，MORPH_NONE 时跳过整个去噪阶段
+static uint32_t morph_cycles;                   // 最近一帧去噪耗时 (周期)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      一行的水平 3 邻域与/或
+// 参数说明      src           压缩行
+// 参数说明      dst           输出：dst 的第 x 位为 src 第 x-1、x、x+1 位的与 (erode) 或或 (!erode)
+// 参数说明      erode         true 为腐蚀 (与)，false 为膨胀 (或)
+// 备注信息      末字的填充位在腐蚀时视为白、膨胀时视为黑，结果的填充位清零。
+//-------------------------------------------------------------------------------------------------------------------
+static void morph_row_horizontal(const uint32_t *src, uint32_t *dst, bool erode)
+{
+    uint32_t pad = erode ? ~0u : 0u; // 图像外像素的取值
+    uint32_t w[BIN_ROW_WORDS];
+
+    for (int i = 0; i < BIN_ROW_WORDS; i++)
+    {
+        w[i] = src[i];
+    }
+    w[BIN_ROW_WORDS - 1] = (w[BIN_ROW_WORDS - 1] & BIN_LAST_WORD_MASK) | (pad & ~BIN_LAST_WORD_MASK);
+
+    for (int i = 0; i < BIN_ROW_WORDS; i++)
+    {
+        uint32_t left_in = (i > 0) ? (w[i - 1] >> 31) : (pad & 1u);                    // x-1 跨字时来自前一个字的最高位
+        uint32_t right_in = (i + 1 < BIN_ROW_WORDS) ? (w[i + 1] << 31) : (pad << 31);   // x+1 跨字时来自后一个字的最低位
+        uint32_t west = (w[i] << 1) | left_in;   // 第 x 位 = 像素 x-1
+        uint32_t east = (w[i] >> 1) | right_in;  // 第 x 位 = 像素 x+1
+        dst[i] = erode ? (w[i] & west & east) : (w[i] | west | east);
+    }
+    dst[BIN_ROW_WORDS - 1] &= BIN_LAST_WORD_MASK;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      3x3 腐蚀或膨胀 (原地)
+// 参数说明      frame         压缩二值图，结果写回原处
+// 参数说明      erode         true 为腐蚀，false 为膨胀
+// 备注信息      第 y 行的结果依赖第 y-1、y、y+1 行，三行的水平结果在写回第 y 行之前都已缓存，所以可以原地覆盖。
+//-------------------------------------------------------------------------------------------------------------------
+static void morph_3x3(BinaryFrame *frame, bool erode)
+{
+    uint32_t buf[3][BIN_ROW_WORDS];
+    uint32_t *above = buf[0];
+    uint32_t *current = buf[1];
+    uint32_t *below = buf[2];
+    uint32_t pad = erode ? ~0u : 0u; // 图像外的行 (填充位由当前行的结果清零)
+
+    for (int i = 0; i < BIN_ROW_WORDS; i++)
+    {
+        above[i] = pad;
+    }
+    morph_row_horizontal(frame->row[0], current, erode);
+
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        if (y + 1 < IMAGE_H)
+        {
+            morph_row_horizontal(frame->row[y + 1], below, erode);
+        }
+        else
+        {
+            for (int i = 0; i < BIN_ROW_WORDS; i++)
+            {
+                below[i] = pad;
+            }
+        }
+
+        for (int i = 0; i < BIN_ROW_WORDS; i++)
+        {
+            frame->row[y][i] = erode ? (above[i] & current[i] & below[i]) : (above[i] | current[i] | below[i]);
+        }
+
+        // 三行缓存轮转
+        uint32_t *t = above;
+        above = current;
+        current = below;
+        below = t;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      对压缩二值图做形态学去噪
+// 参数说明      frame         压缩二值图，结果写回原处
+// 参数说明      mode          去噪方式，见 MorphMode
+// 备注信息      3x3 开运算去掉宽或高不超过 2 个像素的白色噪点，闭运算填上同样大小的黑色噪点；
+//               宽度大于 3 个像素的赛道区域边界保持不变，只有小于结构元的细节 (尖角、窄缝) 会被改变。
+//-------------------------------------------------------------------------------------------------------------------
+void binary_frame_denoise(BinaryFrame *frame, MorphMode mode)
+{
+    if (mode == MORPH_OPEN || mode == MORPH_OPEN_CLOSE)
+    {
+        morph_3x3(frame, true);
+        morph_3x3(frame, false);
+    }
+    if (mode == MORPH_CLOSE || mode == MORPH_OPEN_CLOSE)
+    {
+        morph_3x3(frame, false);
+        morph_3x3(frame, true);
+    }
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（形态学去噪版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      在二值化压缩之后、起点搜索之前插入去噪；morph_mode 为 MORPH_NONE 时与压缩二值图版本完全相同。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 + 形态学去噪 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (morph_mode != MORPH_NONE) {
+        uint32_t t0 = IMAGE_CYCLE_COUNTER();
+        binary_frame_denoise(&binary_frame, morph_mode);
+        morph_cycles = IMAGE_CYCLE_COUNTER() - t0;
+    }
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
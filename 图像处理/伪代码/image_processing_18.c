@@ -0,0 +1,541 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+
+    // 新增的地面坐标结果 (由 ground_edges 计算，供转向控制使用)
+    int16_t ground_offset_mm;    // 前视距离处赛道中心的横向偏差 (mm，向右为正)
+    int16_t ground_width_mm;     // 前视距离处的赛道宽度 (mm)
+    int16_t ground_distance_mm;  // 有效循迹距离 (mm)，无效时为0
+    bool    ground_offset_valid; // 两条边都到达前视距离时为true
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 逆透视变换 (IPM)
+// filtered_edge、final_distance 和贝塞尔控制点都在相机像素坐标里，近大远小，曲率和距离都是畸变的。
+// 这里把边缘点映射到俯视的地面坐标 (单位 mm，x 向右、y 向前，原点为相机在地面上的投影)：
+// 1. 映射由相机标定参数 (安装高度、俯仰角、内参、一阶径向畸变) 在 ipm_init 中一次性算成查找表，
+//    每帧只对跟踪得到的边缘点查表，不变换整幅图像；每个点一次查表加几次整数乘加。
+// 2. 查找表可以在电脑上用同一段代码生成后以 const 数组放进 Flash，MCU 上不再调用 ipm_init。
+// 3. 两种表格式，由 IPM_TABLE_MODE 选择：
+//    IPM_MODE_GRID  每隔 IPM_GRID_STEP 个像素存一个去畸变后的归一化坐标 (Q13)，中间双线性插值，
+//                   再用安装高度和俯仰角按解析式求地面坐标 (两次整数除法)。去畸变坐标随像素平滑变化，插值误差很小；
+//                   直接对地面坐标插值则会在远处 (深度随行号非线性变化) 产生很大误差。步长 1 为逐像素全表 (约 90KB)，
+//                   步长 4 约 6KB、步长 8 约 1.6KB。
+//    IPM_MODE_ROW   每行只存地面 y、x 方向的比例和偏移 (约 1KB)，查表只需一次乘加。相机无侧倾、无畸变时与精确映射相同，
+//                   有畸变时用每行最小二乘直线近似，ipm_init 会统计它与精确映射的最大误差。
+//-------------------------------------------------------------------------------------------------------------------
+#define IPM_MODE_GRID 0
+#define IPM_MODE_ROW  1
+
+#define IPM_TABLE_MODE IPM_MODE_GRID // 表格式
+#define IPM_GRID_STEP  4             // 网格步长 (像素)，取 2 的幂时插值中的除法为移位
+
+// 相机标定参数 (示例值，按实车标定结果修改)
+#define IPM_CAM_HEIGHT_MM 150.0f  // 镜头离地高度
+#define IPM_CAM_PITCH_DEG 30.0f   // 光轴相对水平面向下的俯仰角
+#define IPM_FX            110.0f  // 焦距 (像素)
+#define IPM_FY            110.0f
+#define IPM_CX            93.5f   // 主点
+#define IPM_CY            59.5f
+#define IPM_K1            (-0.15f) // 一阶径向畸变系数
+#define IPM_MAX_RANGE_MM  4000.0f // 超过该前向距离 (或在地平线以上) 的像素视为无效
+#define IPM_LOOKAHEAD_MM  600     // 计算横向偏差的前视距离
+
+#define IPM_INVALID INT16_MIN // 无效点的 y 坐标
+
+typedef struct {
+    int16_t x; // 横向距离 (mm)，向右为正
+    int16_t y; // 前向距离 (mm)
+} ground_point;
+
+// 左右边缘的地面坐标，与 filtered_edge 一一对应 (无效点被跳过)
+typedef struct {
+    ground_point left[IMAGE_H];
+    ground_point right[IMAGE_H];
+    uint16_t     left_count;
+    uint16_t     right_count;
+    int16_t      distance_mm; // final_distance 对应的前向距离，无效时为0
+} GroundEdges;
+
+static GroundEdges ground_edges;
+static bool ipm_ready = false;
+
+#if IPM_TABLE_MODE == IPM_MODE_GRID
+#define IPM_GRID_COLS ((IMAGE_W - 1) / IPM_GRID_STEP + 2)
+#define IPM_GRID_ROWS ((IMAGE_H - 1) / IPM_GRID_STEP + 2)
+#define IPM_NORM_SHIFT 13 // 归一化坐标的定点位数 (Q13，可表示 ±4，即视场角 ±75° 以内)
+
+typedef struct {
+    int16_t x; // 去畸变后的归一化坐标 (Q13)
+    int16_t y;
+} ipm_node;
+
+static ipm_node ipm_grid[IPM_GRID_ROWS][IPM_GRID_COLS];
+static int32_t  ipm_sin_q;      // sinθ (Q13)
+static int32_t  ipm_cos_q;      // cosθ (Q13)
+#else
+static int16_t ipm_row_y[IMAGE_H];      // 该行的前向距离 (mm)，IPM_INVALID 表示整行无效
+static int16_t ipm_row_scale[IMAGE_H];  // 横向比例 (mm/像素，Q8)
+static int32_t ipm_row_offset[IMAGE_H]; // 横向偏移 (mm，Q8)：x = (u * scale + offset) / 256，四舍五入
+static float   ipm_row_max_error_mm;    // 行近似与精确映射的最大误差，用于评估是否可以使用行模式
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      由标定参数精确计算一个像素对应的地面坐标
+// 参数说明      u / v         像素坐标 (可以是网格点，允许超出图像)
+// 参数说明      gx / gy       输出地面坐标 (mm)
+// 返回参数      bool          像素落在地平线以下且在有效距离内返回true
+// 备注信息      ipm_undistort 用迭代法去掉一阶径向畸变，得到归一化坐标；ipm_project_exact 再把归一化坐标的光线与地平面求交。
+//               相机坐标：x 右、y 下、z 沿光轴；地面坐标：x 右、y 前、z 上，相机位于 (0, 0, h)。
+//               光线方向 = (x, cosθ - y·sinθ, -(sinθ + y·cosθ))，与 z = 0 相交于 t = h / (sinθ + y·cosθ)。
+//-------------------------------------------------------------------------------------------------------------------
+static void ipm_undistort(float u, float v, float *x, float *y)
+{
+    float xd = (u - IPM_CX) / IPM_FX;
+    float yd = (v - IPM_CY) / IPM_FY;
+
+    *x = xd;
+    *y = yd;
+    for (int i = 0; i < 5; i++)
+    {
+        float r2 = (*x) * (*x) + (*y) * (*y);
+        *x = xd / (1.0f + IPM_K1 * r2);
+        *y = yd / (1.0f + IPM_K1 * r2);
+    }
+}
+
+#if IPM_TABLE_MODE == IPM_MODE_ROW
+// 只有行模式建表时用到；网格模式在查表时用定点数做同样的求交
+static bool ipm_project_exact(float u, float v, float *gx, float *gy)
+{
+    const float pitch = IPM_CAM_PITCH_DEG * 3.14159265f / 180.0f;
+    const float s = sinf(pitch);
+    const float c = cosf(pitch);
+    float x, y;
+
+    ipm_undistort(u, v, &x, &y);
+
+    float denom = s + y * c;
+    if (denom <= 1e-4f)
+    {
+        return false; // 地平线及以上
+    }
+    float t = IPM_CAM_HEIGHT_MM / denom;
+    *gx = t * x;
+    *gy = t * (c - y * s);
+    return *gy <= IPM_MAX_RANGE_MM && fabsf(*gx) <= 32000.0f;
+}
+#endif
+
+// 四舍五入到整数，存入 int16_t 的调用处由取值范围保证不溢出
+static inline int32_t ipm_round(float v)
+{
+    return (int32_t)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+#if IPM_TABLE_MODE == IPM_MODE_ROW
+// Q8 定点数四舍五入到整数，被除数可能为负；用除法而不是 >> 8，负数右移是实现定义的，而且总是向负无穷取整
+static inline int32_t ipm_q8_round(int32_t v)
+{
+    return (v >= 0) ? (v + 128) / 256 : -((-v + 128) / 256);
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      生成逆透视查找表
+// 备注信息      只在第一次调用时计算，包含三角函数和除法，不要放在每帧的流程里。
+//-------------------------------------------------------------------------------------------------------------------
+void ipm_init(void)
+{
+    if (ipm_ready)
+    {
+        return;
+    }
+
+#if IPM_TABLE_MODE == IPM_MODE_GRID
+    const float pitch = IPM_CAM_PITCH_DEG * 3.14159265f / 180.0f;
+    const float one = (float)(1 << IPM_NORM_SHIFT);
+
+    ipm_sin_q = ipm_round(sinf(pitch) * one);
+    ipm_cos_q = ipm_round(cosf(pitch) * one);
+    for (int gy = 0; gy < IPM_GRID_ROWS; gy++)
+    {
+        for (int gx = 0; gx < IPM_GRID_COLS; gx++)
+        {
+            float x, y;
+            ipm_undistort((float)(gx * IPM_GRID_STEP), (float)(gy * IPM_GRID_STEP), &x, &y);
+            ipm_grid[gy][gx].x = ipm_round(x * one);
+            ipm_grid[gy][gx].y = ipm_round(y * one);
+        }
+    }
+#else
+    ipm_row_max_error_mm = 0.0f;
+    for (int v = 0; v < IMAGE_H; v++)
+    {
+        // 对该行所有有效像素做 x = a·u + b 的最小二乘拟合，y 取平均
+        float su = 0, suu = 0, sx = 0, sux = 0, sy = 0;
+        int n = 0;
+        for (int u = 0; u < IMAGE_W; u++)
+        {
+            float x, y;
+            if (ipm_project_exact((float)u, (float)v, &x, &y))
+            {
+                su += u; suu += (float)u * u; sx += x; sux += u * x; sy += y;
+                n++;
+            }
+        }
+        if (n < IMAGE_W)
+        {
+            ipm_row_y[v] = IPM_INVALID; // 行内有像素超出范围，整行作废
+            continue;
+        }
+        float a = (n * sux - su * sx) / (n * suu - su * su);
+        float b = (sx - a * su) / n;
+        ipm_row_y[v] = ipm_round(sy / n);
+        ipm_row_scale[v] = ipm_round(a * 256.0f);
+        ipm_row_offset[v] = ipm_round(b * 256.0f);
+
+        for (int u = 0; u < IMAGE_W; u++)
+        {
+            float x, y;
+            ipm_project_exact((float)u, (float)v, &x, &y);
+            float ex = fabsf(x - (float)ipm_q8_round(u * ipm_row_scale[v] + ipm_row_offset[v]));
+            float ey = fabsf(y - ipm_row_y[v]);
+            float e = (ex > ey) ? ex : ey;
+            if (e > ipm_row_max_error_mm)
+            {
+                ipm_row_max_error_mm = e;
+            }
+        }
+    }
+#endif
+    ipm_ready = true;
+}
+
+#if IPM_TABLE_MODE == IPM_MODE_GRID
+// 双线性插值的四舍五入除法，被除数可能为负
+static inline int32_t ipm_lerp_div(int32_t sum)
+{
+    const int32_t den = IPM_GRID_STEP * IPM_GRID_STEP;
+    return ((sum >= 0) ? (sum + den / 2) / den : -((-sum + den / 2) / den));
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      查表得到一个像素的地面坐标
+// 参数说明      u / v         像素坐标
+// 参数说明      out           输出地面坐标 (mm)
+// 返回参数      bool          该像素有效返回true
+// 备注信息      网格模式取所在格子的四个角点做整数双线性插值得到归一化坐标 (x, y)，
+//               再按 t = h / (sinθ + y·cosθ) 求交点：地面 x = t·x，y = t·(cosθ - y·sinθ)；
+//               行模式为一次乘加和一次四舍五入的除法 (除数 256，编译为移位加修正)。
+//-------------------------------------------------------------------------------------------------------------------
+bool ipm_lookup(uint8_t u, uint8_t v, ground_point *out)
+{
+#if IPM_TABLE_MODE == IPM_MODE_GRID
+    const uint8_t col = u / IPM_GRID_STEP;
+    const uint8_t row = v / IPM_GRID_STEP;
+    const int32_t wx = u % IPM_GRID_STEP;
+    const int32_t wy = v % IPM_GRID_STEP;
+    const ipm_node *p00 = &ipm_grid[row][col];
+    const ipm_node *p01 = &ipm_grid[row][col + 1];
+    const ipm_node *p10 = &ipm_grid[row + 1][col];
+    const ipm_node *p11 = &ipm_grid[row + 1][col + 1];
+
+    const int32_t w00 = (IPM_GRID_STEP - wx) * (IPM_GRID_STEP - wy);
+    const int32_t w01 = wx * (IPM_GRID_STEP - wy);
+    const int32_t w10 = (IPM_GRID_STEP - wx) * wy;
+    const int32_t w11 = wx * wy;
+    const int32_t x = ipm_lerp_div(w00 * p00->x + w01 * p01->x + w10 * p10->x + w11 * p11->x);
+    const int32_t y = ipm_lerp_div(w00 * p00->y + w01 * p01->y + w10 * p10->y + w11 * p11->y);
+
+    // 分母 (Q13)；分母过小说明在地平线附近或以上
+    const int32_t den = ipm_sin_q + ((y * ipm_cos_q) >> IPM_NORM_SHIFT);
+    if (den <= 0)
+    {
+        return false;
+    }
+    const int32_t h = (int32_t)IPM_CAM_HEIGHT_MM;
+    const int32_t forward = h * (ipm_cos_q - ((y * ipm_sin_q) >> IPM_NORM_SHIFT));
+    if (forward > (int32_t)IPM_MAX_RANGE_MM * den)
+    {
+        return false;
+    }
+    const int32_t lateral = h * x;
+    if (lateral > 32000 * den || lateral < -32000 * den)
+    {
+        return false;
+    }
+    out->x = (int16_t)(lateral / den);
+    out->y = (int16_t)(forward / den);
+    return true;
+#else
+    if (ipm_row_y[v] == IPM_INVALID)
+    {
+        return false;
+    }
+    out->x = (int16_t)ipm_q8_round((int32_t)u * ipm_row_scale[v] + ipm_row_offset[v]);
+    out->y = ipm_row_y[v];
+    return true;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把一条边的 filtered_edge 变换到地面坐标
+// 参数说明      tracker       边缘跟踪器 (读取 filtered_edge / filtered_points_count)
+// 参数说明      out           输出数组，容量 IMAGE_H
+// 返回参数      uint16_t      输出的有效点数
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t ipm_transform_edge(const EdgeTracker *tracker, ground_point *out)
+{
+    uint16_t n = 0;
+    for (int i = 0; i < tracker->filtered_points_count; i++)
+    {
+        if (ipm_lookup(tracker->filtered_edge[i].x, tracker->filtered_edge[i].y, &out[n]))
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把左右边缘和有效循迹距离变换到地面坐标
+// 参数说明      context       读取 filtered_edge 和 final_distance
+// 参数说明      ground        输出
+// 备注信息      final_distance 是“IMAGE_H - 最远行”，这里取最远行在图像中线上的前向距离。
+//-------------------------------------------------------------------------------------------------------------------
+void ipm_transform_context(const TrackContext *context, GroundEdges *ground)
+{
+    ground_point far_point;
+
+    ground->left_count = ipm_transform_edge(&context->left_edge, ground->left);
+    ground->right_count = ipm_transform_edge(&context->right_edge, ground->right);
+
+    ground->distance_mm = 0;
+    if (context->final_distance > 0 && context->final_distance <= IMAGE_H &&
+        ipm_lookup(IMAGE_W / 2, (uint8_t)(IMAGE_H - context->final_distance), &far_point))
+    {
+        ground->distance_mm = far_point.y;
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在一条边的地面坐标中找前视距离处的横向位置
+// 参数说明      pts / count   地面坐标点 (ipm_transform_edge 的输出)
+// 参数说明      lookahead_mm  前视距离
+// 参数说明      x             输出横向位置 (mm)
+// 返回参数      bool          这条边到达前视距离时返回true
+// 备注信息      filtered_edge 自下而上排列，地面 y 随之递增，取第一个 y >= lookahead_mm 的点与前一点线性插值。
+//-------------------------------------------------------------------------------------------------------------------
+static bool ipm_edge_x_at(const ground_point *pts, uint16_t count, int16_t lookahead_mm, int16_t *x)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (pts[i].y < lookahead_mm)
+        {
+            continue;
+        }
+        if (i == 0 || pts[i].y == pts[i - 1].y)
+        {
+            *x = pts[i].x;
+            return true;
+        }
+        const int32_t dy = pts[i].y - pts[i - 1].y;
+        *x = (int16_t)(pts[i - 1].x + (int32_t)(pts[i].x - pts[i - 1].x) * (lookahead_mm - pts[i - 1].y) / dy);
+        return true;
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      由左右边缘的地面坐标求前视距离处赛道中心的横向偏差和赛道宽度
+// 参数说明      ground        ipm_transform_context 的输出
+// 参数说明      lookahead_mm  前视距离
+// 参数说明      offset_mm     输出横向偏差 (mm，向右为正)
+// 参数说明      width_mm      输出赛道宽度 (mm)
+// 返回参数      bool          左右两条边都到达前视距离时返回true
+// 备注信息      像素坐标中远处的偏差被透视压缩，同样偏 1 像素在近处和远处对应的距离相差数倍；
+//               这里的偏差以 mm 为单位，与距离无关，可以直接作为转向控制的输入，宽度可用于检查边缘是否可信。
+//-------------------------------------------------------------------------------------------------------------------
+bool ipm_center_offset(const GroundEdges *ground, int16_t lookahead_mm, int16_t *offset_mm, int16_t *width_mm)
+{
+    int16_t left_x, right_x;
+
+    if (!ipm_edge_x_at(ground->left, ground->left_count, lookahead_mm, &left_x) ||
+        !ipm_edge_x_at(ground->right, ground->right_count, lookahead_mm, &right_x))
+    {
+        return false;
+    }
+    *offset_mm = (int16_t)((left_x + right_x) / 2);
+    *width_mm = (int16_t)(right_x - left_x);
+    return true;
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（逆透视版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      像素坐标的结果保持不变，地面坐标另存于 ground_edges，再由它求出前视距离处的横向偏差、赛道宽度
+//               和有效循迹距离 (mm) 写入 context，供转向控制使用。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+    ipm_init(); // 仅第一次调用时生成查找表
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 逆透视：只变换提纯后的边缘点 ---
+    ipm_transform_context(context, &ground_edges);
+    context->ground_distance_mm = ground_edges.distance_mm;
+    context->ground_offset_valid = ipm_center_offset(&ground_edges, IPM_LOOKAHEAD_MM, &context->ground_offset_mm,
+                                                     &context->ground_width_mm);
+
+    // --- 6. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
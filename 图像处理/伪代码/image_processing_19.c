@@ -0,0 +1,394 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+// 定义边缘提取算法的参数，这些参数决定了算法的灵敏度和鲁棒性
+#define MIN_VALID_SEGMENT_LENGTH   6   // 一个边缘段被认为是有效的最小连续行数
+#define MAX_EDGE_HORIZONTAL_JUMP   8   // 连续两行之间允许的最大水平像素跳变
+#define INVALID_EDGE_LEFT_X        1   // 左侧无效边缘的X坐标 (黑边框)
+#define INVALID_EDGE_RIGHT_X       (IMAGE_W - 2) // 右侧无效边缘的X坐标
+
+// 定义函数内部使用的状态机状态
+typedef enum {
+    STATE_SEARCHING, // 状态：正在从下往上寻找有效线段的起点
+    STATE_TRACKING   // 状态：已找到起点，正在跟踪一个有效的线段
+} EdgeExtractionState;
+
+//-------------------------------------------------------------------------------------------------------------------
+// 弯心与最大偏离
+// EdgeTracker 里的 turn_center / max_deviation / is_turn_found 定义为：提纯后的边缘段中，离首尾两点连线 (弦) 最远的点、
+// 它到弦的垂直距离 (像素，向下取整；点在弦的 x 增大一侧为正) 以及偏离是否达到 TURN_MIN_DEVIATION。
+// 弦的终点要等提纯结束才确定，所以在线段定下来之后再对 filtered_edge 做一遍整数扫描：提纯后的边缘每行恰好一个点，
+// 把第 k 个点看作 (k, x_k)，设弦向量 D = (n, x_n - x_0)，点 k 的有符号面积 f(k) = n·(x_k - x_0) - (x_n - x_0)·k (整数叉积)，
+// 循环里只有乘加和比较，|f| 最大的点就是弯心，最后做一次整数开方得到距离。
+//-------------------------------------------------------------------------------------------------------------------
+#define TURN_MIN_DEVIATION 3 // 判定为弯道的最小偏离 (像素)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      32位整数平方根 (向下取整)
+//-------------------------------------------------------------------------------------------------------------------
+static uint16_t isqrt32(uint32_t v)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v)
+    {
+        bit >>= 2;
+    }
+    while (bit != 0)
+    {
+        if (v >= root + bit)
+        {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      扫描提纯后的线段，求弯心、最大偏离和弯道标志
+// 参数说明      tracker       读取 filtered_edge，写入 turn_center / max_deviation / is_turn_found
+// 参数说明      count         线段点数 (extract_single_edge_turn 的最终结果，0 表示无效)
+// 备注信息      |f| 相同时取下标较小的点。距离 = |f| / |D|，只在最后做一次整数开方。
+//-------------------------------------------------------------------------------------------------------------------
+static void turn_scan(EdgeTracker *tracker, int count)
+{
+    const point *edge = tracker->filtered_edge;
+
+    tracker->turn_center.x = 0;
+    tracker->turn_center.y = 0;
+    tracker->max_deviation = 0;
+    tracker->is_turn_found = false;
+    if (count < 3)
+    {
+        return;
+    }
+
+    const int32_t n = count - 1;
+    const int32_t x0 = edge[0].x;
+    const int32_t dx = (int32_t)edge[n].x - x0;
+    int32_t best_f = 0;
+    uint32_t best_af = 0;
+    int best_k = 0;
+
+    for (int32_t k = 1; k < n; k++)
+    {
+        const int32_t f = n * ((int32_t)edge[k].x - x0) - dx * k;
+        const uint32_t af = (uint32_t)(f >= 0 ? f : -f);
+        if (af > best_af)
+        {
+            best_af = af;
+            best_f = f;
+            best_k = k;
+        }
+    }
+
+    const uint32_t chord2 = (uint32_t)(n * n + dx * dx);
+    const int16_t deviation = (int16_t)isqrt32((uint32_t)(((uint64_t)best_af * best_af) / chord2));
+
+    tracker->turn_center = edge[best_k];
+    tracker->max_deviation = (best_f >= 0) ? deviation : -deviation;
+    tracker->is_turn_found = (deviation >= TURN_MIN_DEVIATION);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      从“行地图”中提取最长、最连续的有效边缘段，同时计算弯心
+// 参数说明      tracker       指向边缘跟踪器的指针，函数会读取其中的mapped_edge并写入filtered_edge和弯心
+// 参数说明      polarity      指示当前处理的是左边缘还是右边缘
+// 备注信息      状态机与 extract_single_edge 完全相同，线段确定之后再扫描一遍求弯心。
+//-------------------------------------------------------------------------------------------------------------------
+static void extract_single_edge_turn(EdgeTracker *tracker, EdgePolarity polarity)
+{
+    // 从 tracker 结构体中获取所需的数据指针和参数，简化后续代码
+    uint8_t *most_edge = tracker->mapped_edge;       // 输入：行地图
+    point *reality_edge = tracker->filtered_edge;    // 输出：滤波后的边缘点
+    uint8_t start_y = tracker->mapped_edge_start_y;  // 起始扫描行
+    
+    // 根据是左边缘还是右边缘，确定无效区域的X坐标
+    const uint8_t invalid_edge_x = (polarity == 0) ? INVALID_EDGE_LEFT_X : INVALID_EDGE_RIGHT_X;
+    // 扫描的上限（最高点）
+    const uint8_t upper_bound_y = tracker->mapped_edge_end_y;
+
+    // 重置输出结果和状态标志
+    tracker->filtered_points_count = 0;
+    tracker->breakpoint_flag = false;
+
+    // 初始化状态机
+    EdgeExtractionState state = STATE_SEARCHING;
+    int count = 0; // 用于记录当前有效线段的长度
+
+    // 核心算法：从起始行(图像底部附近)向上扫描，直到边缘的最高点
+    for (int y = start_y; y > upper_bound_y; y--)
+    {
+        const uint8_t current_x = most_edge[y];
+        
+        switch (state)
+        {
+            // 搜索状态：寻找第一个不是无效点的像素，作为线段的起点
+            case STATE_SEARCHING:
+                if (current_x != invalid_edge_x)
+                {
+                    // 找到起点，切换到跟踪状态
+                    state = STATE_TRACKING;
+                    // 关键技巧：将y加1，使循环在下一次迭代时重新处理当前行。
+                    // 这样，找到的第一个点就会被作为有效线段的第一个点记录下来。
+                    y++;
+                    count = 0;
+                }
+                break;
+
+            // 跟踪状态：持续记录连续的边缘点
+            case STATE_TRACKING:
+            {
+                // 判断当前点是否构成“断点”
+                bool is_discontinuous = (current_x == invalid_edge_x);
+                // 条件1：当前点本身是无效点
+                if (!is_discontinuous && count > 0)
+                {
+                    int last_x = reality_edge[count - 1].x;
+                    // 条件2：当前点与上一个点水平距离过大（跳变）
+                    if (abs(current_x - last_x) > MAX_EDGE_HORIZONTAL_JUMP)
+                    {
+                        is_discontinuous = true;
+                        // 修改点：直接写入 tracker 的标志位
+                        tracker->breakpoint_flag = true;  // 记录发生了跳变
+                    }
+                }
+                // 如果发生了断点
+                if (is_discontinuous)
+                {
+                    // 检查已跟踪的线段长度是否足够长
+                    if (count >= MIN_VALID_SEGMENT_LENGTH)
+                    {
+                        // 如果足够长，说明我们找到了一个有效的主边缘段，任务完成。
+                        goto extraction_finished;
+                    }
+                    else
+                    {
+                        // 如果线段太短，则认为是噪声，抛弃它
+                        state = STATE_SEARCHING; // 回到搜索状态，寻找下一个可能的起点
+                        count = 0;
+                    }
+                }
+                else // 如果没有断点，说明边缘是连续的
+                {
+                    // 将当前点记录到结果数组中
+                    reality_edge[count].x = current_x;
+                    reality_edge[count].y = (uint8_t)y;
+                    count++;
+                }
+                break;
+            }
+        }
+    }
+extraction_finished:
+    // 循环结束后，对找到的最后一段进行有效性检查
+    if (count < MIN_VALID_SEGMENT_LENGTH)
+    {
+        count = 0;
+        tracker->is_found = false;
+    }
+    else
+    {
+        tracker->is_found = true; // 最终找到的线段是有效的
+    }
+    
+    // 将最终统计到的有效点数存回 tracker 结构体
+    tracker->filtered_points_count = count;
+
+    // 弯心
+    turn_scan(tracker, count);
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      边缘处理流程的总调度函数（带弯心计算）
+// 备注信息      与 extract_and_filter_edges 相同，边缘提纯换成 extract_single_edge_turn。
+//-------------------------------------------------------------------------------------------------------------------
+void extract_and_filter_edges_turn(TrackContext *context)
+{
+    // --- 1. 格式转换 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+
+    // --- 2. 边缘提纯 + 弯心 ---
+    extract_single_edge_turn(&context->left_edge, EDGE_LEFT);
+    extract_single_edge_turn(&context->right_edge, EDGE_RIGHT);
+
+    // --- 3. 计算有效循迹距离 ---
+    // 有效距离取决于左右两边中，走得更“远”（y坐标更小）的那一边。
+    uint8_t left_end_y = context->left_edge.mapped_edge_end_y;
+    uint8_t right_end_y = context->right_edge.mapped_edge_end_y;
+
+    if(left_end_y <= right_end_y && left_end_y > 0)
+    {
+        context->final_distance = IMAGE_H - left_end_y;
+    }
+    else if (right_end_y < left_end_y && right_end_y > 0)
+    {
+        context->final_distance = IMAGE_H - right_end_y;
+    }
+}
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（弯心版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      提纯完成后左右边缘的 turn_center / max_deviation / is_turn_found 即可直接使用。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段：提纯的同时得到弯心 ---
+    extract_and_filter_edges_turn(context);
+
+    // --- 5. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+// 链码拐点类型
+typedef enum {
+    CORNER_INWARD = 0,  // 向赛道内侧的拐角 (左边界右转、右边界左转)
+    CORNER_OUTWARD,     // 向赛道外侧的拐角
+    CORNER_INFLECTION   // 拐点：前后两个拐角方向相反，位于两者之间
+} ChainCornerType;
+
+// 链码拐点，index 为 raw_edge_points 中的下标
+typedef struct {
+    point   position;
+    uint8_t index;
+    int8_t  turn;  // 平滑窗口内的方向变化，单位 45°，正为向内侧；拐点为0
+    uint8_t type;  // ChainCornerType
+} ChainCorner;
+
+#define CHAIN_MAX_CORNERS 8 // 每条边最多记录的拐角/拐点数
+
+// 一条边的拐角/拐点列表 (按跟踪顺序)
+typedef struct {
+    ChainCorner corners[CHAIN_MAX_CORNERS];
+    uint8_t     count;
+} ChainCornerList;
+
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+
+    // 新增的链码拐点成员 (放在末尾，EdgeTracker 与其他章节的布局保持一致，
+    // 其他章节编译的 search_line_packed、extract_and_filter_edges_fused 才能直接处理本章的 TrackContext)
+    ChainCornerList left_corners;
+    ChainCornerList right_corners;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 链码曲率与拐角检测
+// search_line 在 raw_direction[] 中记录了每一步的 Freeman 链码 (raw_direction[i] 为第 i-1 点走到第 i 点的方向)，
+// 这里直接从链码求局部曲率和拐角，不需要重新扫描图像，也不需要拟合曲线：
+// 1. 相邻两步的方向差 ((d[i+1] - d[i] + 4) & 7) - 4 即该点的转角 (单位 45°)。第1步是从起点 (不在轮廓上) 走上轮廓，
+//    方向不可靠，不参与计算。左边界的方向表为顺时针、右边界为逆时针，
+//    所以两条边上转角为正都表示向赛道内侧弯。
+// 2. 转角的前缀和 U 是“展开”后的方向，平滑曲率取滑动窗口和 K(i) = U[i + h] - U[i + 1 - h]，即该点前后各 h 步的总转角，
+//    每点一次减法。斜直线的阶梯链码在窗口内的转角和只在 -1..1 之间抖动，|K| >= CHAIN_CORNER_MIN_TURN 才是真实的拐角。
+// 3. 同号且连续非0的一段 K 称为一个“瓣”，峰值达到阈值的瓣记为一个拐角，位置取峰值平台的中点；
+//    相邻两个拐角方向相反时，在两者之间记一个拐点 (S 弯、环岛入口)。
+// 4. 赛道碰到图像边缘时轮廓会沿边框走，产生的拐角与赛道形状无关。平滑窗口内有点贴着图像边缘 (最外一圈白像素) 的拐角
+//    不记录，也不参与拐点判断。
+//-------------------------------------------------------------------------------------------------------------------
+#define CHAIN_HALF_WINDOW     5 // 平滑半窗口 h (步)
+#define CHAIN_CORNER_MIN_TURN 2 // 拐角的最小窗口转角 (单位 45°，2 即 90°)
+#define CHAIN_CORNER_MIN_SPAN 3 // |K| 达到 MIN_TURN 的最少点数，滤掉斜率跨过 45° 时量化产生的单点尖峰
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      由链码计算平滑曲率
+// 参数说明      tracker       读取 raw_direction / raw_points_count
+// 参数说明      curvature     输出，curvature[i] 为第 i 点的窗口转角 (单位 45°)，窗口不完整的首尾点为0
+// 返回参数      uint16_t      点数 (raw_points_count + 1)
+//-------------------------------------------------------------------------------------------------------------------
+uint16_t chain_curvature(const EdgeTracker *tracker, int8_t *curvature)
+{
+    const uint16_t steps = tracker->raw_points_count; // 第 1..steps 步
+    const uint8_t *dir = tracker->raw_direction;
+    int16_t unwrapped[MAX_EDGE_POINTS];
+
+    memset(curvature, 0, steps + 1);
+    if (steps < 2 * CHAIN_HALF_WINDOW + 1)
+    {
+        return steps + 1;
+    }
+
+    // 1. 展开方向：U[s] = U[s-1] + 第 s-1 点处的转角，从第2步开始
+    unwrapped[2] = 0;
+    for (uint16_t s = 3; s <= steps; s++)
+    {
+        int8_t turn = (int8_t)(((dir[s] - dir[s - 1] + 4) & 7) - 4);
+        unwrapped[s] = unwrapped[s - 1] + turn;
+    }
+
+    // 2. 滑动窗口和：第 i 点连接第 i 步和第 i+1 步，前后各 h 步
+    for (uint16_t i = CHAIN_HALF_WINDOW + 1; i + CHAIN_HALF_WINDOW <= steps; i++)
+    {
+        curvature[i] = (int8_t)(unwrapped[i + CHAIN_HALF_WINDOW] - unwrapped[i + 1 - CHAIN_HALF_WINDOW]);
+    }
+    return steps + 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      判断拐角的平滑窗口内是否有点贴着图像边缘
+// 参数说明      first / last  峰值平台的首尾下标，向两侧各扩展 CHAIN_HALF_WINDOW 个点
+// 备注信息      只在检测到拐角时调用，最多检查几十个点。
+//-------------------------------------------------------------------------------------------------------------------
+static bool chain_touches_border(const EdgeTracker *tracker, uint16_t first, uint16_t last)
+{
+    uint16_t from = (first > CHAIN_HALF_WINDOW) ? first - CHAIN_HALF_WINDOW : 0;
+    uint16_t to = (last + CHAIN_HALF_WINDOW < tracker->raw_points_count) ? last + CHAIN_HALF_WINDOW : tracker->raw_points_count;
+
+    for (uint16_t i = from; i <= to; i++)
+    {
+        point p = tracker->raw_edge_points[i];
+        if (p.x <= 1 || p.x >= IMAGE_W - 2 || p.y <= 1 || p.y >= IMAGE_H - 2)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      追加一个拐角或拐点
+//-------------------------------------------------------------------------------------------------------------------
+static void chain_add_corner(const EdgeTracker *tracker, ChainCornerList *list, uint8_t index, int8_t turn,
+                             ChainCornerType type)
+{
+    if (list->count >= CHAIN_MAX_CORNERS)
+    {
+        return;
+    }
+    ChainCorner *corner = &list->corners[list->count++];
+    corner->position = tracker->raw_edge_points[index];
+    corner->index = index;
+    corner->turn = turn;
+    corner->type = (uint8_t)type;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      从链码中找出拐角与拐点
+// 参数说明      tracker       读取链码
+// 参数说明      list          输出拐角与拐点 (按跟踪顺序)
+// 备注信息      一次扫描曲率：遇到符号变化或0就结束当前的瓣，瓣内记录峰值及峰值第一次、最后一次出现的位置。
+//-------------------------------------------------------------------------------------------------------------------
+void chain_find_corners(const EdgeTracker *tracker, ChainCornerList *list)
+{
+    int8_t curvature[MAX_EDGE_POINTS];
+    const uint16_t points = chain_curvature(tracker, curvature);
+
+    int8_t lobe_sign = 0;        // 当前瓣的符号，0 表示不在瓣内
+    int8_t lobe_peak = 0;        // 当前瓣的峰值 (带符号)
+    uint16_t peak_first = 0;     // 峰值第一次出现的位置
+    uint16_t peak_last = 0;      // 峰值最后一次出现的位置
+    uint16_t strong_span = 0;    // 瓣内 |K| >= CHAIN_CORNER_MIN_TURN 的点数
+    int8_t last_corner_sign = 0; // 上一个拐角的方向
+    uint16_t last_corner_end = 0;// 上一个拐角所在瓣的结束位置
+
+    list->count = 0;
+
+    for (uint16_t i = 0; i <= points; i++)
+    {
+        const int8_t k = (i < points) ? curvature[i] : 0; // 末尾补0，结束最后一个瓣
+        const int8_t sign = (k > 0) - (k < 0);
+
+        if (sign != lobe_sign && lobe_sign != 0)
+        {
+            // 瓣结束
+            const uint8_t corner_index = (uint8_t)((peak_first + peak_last) / 2);
+            const bool is_corner = (strong_span >= CHAIN_CORNER_MIN_SPAN);
+            if (is_corner && chain_touches_border(tracker, peak_first, peak_last))
+            {
+                last_corner_sign = 0; // 边框拐角：丢弃，且不跨过它判断拐点
+            }
+            else if (is_corner)
+            {
+                // 与上一个拐角方向相反：拐点取两个峰值平台之间的中点
+                if (last_corner_sign != 0 && last_corner_sign != lobe_sign)
+                {
+                    chain_add_corner(tracker, list, (uint8_t)((last_corner_end + peak_first) / 2), 0, CORNER_INFLECTION);
+                }
+                chain_add_corner(tracker, list, corner_index, lobe_peak,
+                                 (lobe_sign > 0) ? CORNER_INWARD : CORNER_OUTWARD);
+                last_corner_sign = lobe_sign;
+                last_corner_end = peak_last;
+            }
+            lobe_sign = 0;
+        }
+
+        if (sign != 0 && lobe_sign == 0)
+        {
+            // 新瓣开始
+            lobe_sign = sign;
+            lobe_peak = k;
+            peak_first = peak_last = i;
+            strong_span = 0;
+        }
+        else if (sign != 0)
+        {
+            if (k * sign > lobe_peak * sign)
+            {
+                lobe_peak = k;
+                peak_first = peak_last = i;
+            }
+            else if (k == lobe_peak)
+            {
+                peak_last = i;
+            }
+        }
+
+        if (sign != 0 && k * sign >= CHAIN_CORNER_MIN_TURN)
+        {
+            strong_span++;
+        }
+    }
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（链码拐角版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      循迹结束后直接分析链码，left_corners / right_corners 可用于十字、环岛入口等元素的判断。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 链码拐角 ---
+    chain_find_corners(&context->left_edge, &context->left_corners);
+    chain_find_corners(&context->right_edge, &context->right_corners);
+
+    // --- 5. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 6. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 中线每一行的来源
+typedef enum {
+    MID_SOURCE_NONE = 0, // 该行没有中线
+    MID_SOURCE_BOTH,     // 左右边缘取平均
+    MID_SOURCE_LEFT,     // 只有左边缘，按赛道宽度表向右补半宽
+    MID_SOURCE_RIGHT     // 只有右边缘，按赛道宽度表向左补半宽
+} MidSource;
+
+#define MID_FRAC_BITS 4 // 中线与赛道宽度的定点小数位数 (Q4，1/16 像素)
+
+// 中线结果，所有数组按行号索引
+typedef struct {
+    int16_t mid[IMAGE_H];      // 中线 x (Q4)，单边补线时可能超出图像
+    uint8_t source[IMAGE_H];   // MidSource
+    uint8_t start_y;           // 中线最底行
+    uint8_t end_y;             // 中线最高行
+    uint8_t valid_rows;        // source 不为 NONE 的行数
+    int16_t steering_error;    // 加权偏差 (Q4 像素)，中线在图像中心右侧为正
+    bool    is_found;          // 本帧偏差是否有效，无效时 steering_error 保持上一帧的值
+} MidLine;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+
+    // 新增的中线成员
+    MidLine mid_line;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 中线合成
+// 提取得到的是左右两条独立的 filtered_edge，控制代码过去要再遍历一次重建中线，并且单边丢线时各自特殊处理。
+// 这里一次遍历两条边的行区间，直接得到逐行中线 mid[y] 和加权偏差：
+// 1. filtered_edge 每行一个点、行号逐点减1，第 y 行在数组中的下标为 filtered_edge[0].y - y，不需要再查 mapped_edge。
+// 2. 两边都有点的行取平均；只有一边的行用“按行号的赛道宽度表”补半个宽度。宽度表初值按针孔模型
+//    (地面上等宽的赛道在图像中的宽度与该行到地平线的距离成正比) 生成，之后每帧用两边都有点的行在线修正，
+//    自动适应实际的安装高度和俯仰角；宽度与表值相差一倍以上的行 (十字、环岛入口) 不参与修正。
+// 3. 偏差为 Σw(y)·(mid[y] - 图像中心) / Σw(y)，w 是以前瞻行为中心的三角窗，补线行的权重减半。整帧只有一次除法。
+// 4. 全部为整数运算 (Q4)，不分配内存，结果写入 context->mid_line。
+//-------------------------------------------------------------------------------------------------------------------
+#define MID_WIDTH_BOTTOM_PX   150  // 底行 (y = IMAGE_H - 1) 赛道宽度的初值 (像素)
+#define MID_HORIZON_Y         (-4) // 地平线所在的行 (可在图像外)，初值宽度在该行为0
+#define MID_WIDTH_LEARN_SHIFT 3    // 宽度表的在线修正速率 (每次修正差值的 1/8)
+#define MID_LOOKAHEAD_Y       70   // 前瞻行：偏差权重最大的行
+#define MID_LOOKAHEAD_SPAN    40   // 三角窗半宽 (行)，|y - MID_LOOKAHEAD_Y| >= 该值的行权重为0
+
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u // 可映射到 DWT->CYCCNT 以统计耗时
+#endif
+
+#define MID_CENTER_Q (((IMAGE_W - 1) << MID_FRAC_BITS) / 2) // 图像中心 x (Q4)
+
+static uint16_t mid_track_width[IMAGE_H]; // 每行的赛道宽度 (Q4 像素)
+static uint8_t  mid_weight[IMAGE_H];      // 每行的偏差权重
+static bool     midline_ready = false;
+static uint32_t midline_cycles;           // 最近一帧中线合成耗时 (周期)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      生成赛道宽度表和偏差权重表
+// 备注信息      只在第一次调用时计算；宽度表之后由 build_midline 在线修正。
+//-------------------------------------------------------------------------------------------------------------------
+void midline_init(void)
+{
+    if (midline_ready)
+    {
+        return;
+    }
+
+    for (int y = 0; y < IMAGE_H; y++)
+    {
+        int32_t width = 0;
+        if (y > MID_HORIZON_Y)
+        {
+            width = ((int32_t)MID_WIDTH_BOTTOM_PX << MID_FRAC_BITS) * (y - MID_HORIZON_Y) / (IMAGE_H - 1 - MID_HORIZON_Y);
+        }
+        mid_track_width[y] = (uint16_t)width;
+
+        int weight = MID_LOOKAHEAD_SPAN - abs(y - MID_LOOKAHEAD_Y);
+        mid_weight[y] = (uint8_t)(weight > 0 ? weight : 0);
+    }
+    midline_ready = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      由左右 filtered_edge 合成中线并计算加权偏差
+// 参数说明      context       读取 left_edge / right_edge 的提纯结果，写入 context->mid_line
+// 备注信息      须在 extract_and_filter_edges 之后调用。两条边都没找到时 mid_line.valid_rows 为0。
+//               中线的行区间是两条边行区间的并集，中间两边都没有点的行 source 为 MID_SOURCE_NONE。
+//-------------------------------------------------------------------------------------------------------------------
+void build_midline(TrackContext *context)
+{
+    const EdgeTracker *left = &context->left_edge;
+    const EdgeTracker *right = &context->right_edge;
+    MidLine *line = &context->mid_line;
+
+    const int left_count = left->is_found ? left->filtered_points_count : 0;
+    const int right_count = right->is_found ? right->filtered_points_count : 0;
+    const int left_bottom = left_count ? left->filtered_edge[0].y : -1;
+    const int right_bottom = right_count ? right->filtered_edge[0].y : -1;
+    const int left_top = left_count ? left_bottom - left_count + 1 : IMAGE_H;
+    const int right_top = right_count ? right_bottom - right_count + 1 : IMAGE_H;
+
+    const int bottom = (left_bottom > right_bottom) ? left_bottom : right_bottom;
+    const int top = (left_top < right_top) ? left_top : right_top;
+
+    line->valid_rows = 0;
+    if (bottom < 0)
+    {
+        line->is_found = false;
+        return;
+    }
+    line->start_y = (uint8_t)bottom;
+    line->end_y = (uint8_t)top;
+
+    int32_t error_sum = 0;  // Σ w·(mid - 中心)
+    int32_t weight_sum = 0; // Σ w
+
+    for (int y = bottom; y >= top; y--)
+    {
+        const unsigned li = (unsigned)(left_bottom - y);   // 负数转成无符号后一定越界
+        const unsigned ri = (unsigned)(right_bottom - y);
+        const bool has_left = li < (unsigned)left_count;
+        const bool has_right = ri < (unsigned)right_count;
+        int32_t weight = mid_weight[y];
+        int32_t mid;
+
+        if (has_left && has_right)
+        {
+            const int32_t lx = left->filtered_edge[li].x;
+            const int32_t rx = right->filtered_edge[ri].x;
+            mid = (lx + rx) << (MID_FRAC_BITS - 1);
+            line->source[y] = MID_SOURCE_BOTH;
+
+            // 在线修正宽度表，明显偏离的行 (十字、环岛入口等) 不参与
+            const int32_t measured = (rx - lx) << MID_FRAC_BITS;
+            const int32_t expected = mid_track_width[y];
+            if (measured > 0 && 2 * measured > expected && measured < 2 * expected)
+            {
+                mid_track_width[y] = (uint16_t)(expected + ((measured - expected) >> MID_WIDTH_LEARN_SHIFT));
+            }
+        }
+        else if (has_left)
+        {
+            mid = ((int32_t)left->filtered_edge[li].x << MID_FRAC_BITS) + (mid_track_width[y] >> 1);
+            line->source[y] = MID_SOURCE_LEFT;
+            weight >>= 1;
+        }
+        else if (has_right)
+        {
+            mid = ((int32_t)right->filtered_edge[ri].x << MID_FRAC_BITS) - (mid_track_width[y] >> 1);
+            line->source[y] = MID_SOURCE_RIGHT;
+            weight >>= 1;
+        }
+        else
+        {
+            line->source[y] = MID_SOURCE_NONE;
+            continue;
+        }
+
+        line->mid[y] = (int16_t)mid;
+        line->valid_rows++;
+        error_sum += weight * (mid - MID_CENTER_Q);
+        weight_sum += weight;
+    }
+
+    // 前瞻窗内没有任何中线点时保持上一帧的偏差
+    line->is_found = (weight_sum > 0);
+    if (line->is_found)
+    {
+        line->steering_error = (int16_t)(error_sum / weight_sum);
+    }
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（中线合成版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      中线合成紧跟在边缘提纯之后，耗时计入 midline_cycles，与其它阶段一起核算单帧预算。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+    midline_init(); // 仅第一次调用时生成宽度表和权重表
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 中线合成 ---
+    uint32_t t0 = IMAGE_CYCLE_COUNTER();
+    build_midline(context);
+    midline_cycles = IMAGE_CYCLE_COUNTER() - t0;
+
+    // --- 6. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
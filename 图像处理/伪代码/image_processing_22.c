@@ -0,0 +1,393 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+#define BEZIER_MAX_SEGMENTS 4 // 每条边最多的分段数
+
+// 分段贝塞尔中的一段，first / last 为该段首尾点在 filtered_edge 中的下标，相邻两段共用分割点
+typedef struct {
+    CubicBezier curve;
+    uint8_t     first;
+    uint8_t     last;
+    float       max_error; // 该段的最大点到曲线距离 (像素)
+} BezierSegment;
+
+// 一条边的分段拟合结果
+typedef struct {
+    BezierSegment segment[BEZIER_MAX_SEGMENTS]; // 按下标从小到大排列
+    uint8_t       segment_count;                // 0 表示没有拟合
+    uint8_t       iterations;                   // 本帧执行的单段拟合次数
+    float         max_error;                    // 所有段中的最大误差 (像素)
+} BezierPiecewise;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+
+    // 新增的分段贝塞尔成员
+    BezierPiecewise left_pieces;
+    BezierPiecewise right_pieces;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 分段贝塞尔拟合
+// fit_bezier_curve 用一条三阶曲线拟合整条 filtered_edge，S 弯上误差很大，控制代码只好退回使用原始点。
+// 这里在误差超限时把误差最大的一段在其最远点处一分为二，各自重新拟合，直到：
+// 1. 所有段的最大点到曲线距离都不超过容差，或
+// 2. 段数达到 BEZIER_MAX_SEGMENTS，或剩下超限的段都已短到不能再分 (每段至少 BEZIER_MIN_SEGMENT_POINTS 个点)。
+// 每段仍用 fit_bezier_curve (首尾点固定 + 弦长参数化 + 最小二乘)，相邻段共用分割点，位置连续 (C0)。
+// 点到曲线的距离以弦长参数 t 为初值、做 BEZIER_NEWTON_STEPS 次牛顿迭代求最近点后计算，比直接用 |Q(t) - P| 更接近真实距离，
+// 不会把参数化误差当成拟合误差而多分段。
+//-------------------------------------------------------------------------------------------------------------------
+#define BEZIER_FIT_TOLERANCE      1.5f // 允许的最大点到曲线距离 (像素)
+#define BEZIER_MIN_SEGMENT_POINTS 6    // 每段最少的点数
+#define BEZIER_NEWTON_STEPS       3    // 求最近点的牛顿迭代次数
+
+CubicBezier fit_bezier_curve(const point* points, int count); // 单段拟合，实现见 image_processing_04.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      计算三阶贝塞尔曲线在 t 处的位置及一、二阶导数
+//-------------------------------------------------------------------------------------------------------------------
+static void bezier_eval_derivatives(const CubicBezier *c, float t, point_f *q, point_f *d1, point_f *d2)
+{
+    float u = 1.0f - t;
+    float b0 = u * u * u, b1 = 3.0f * t * u * u, b2 = 3.0f * t * t * u, b3 = t * t * t;
+    q->x = b0 * c->p0.x + b1 * c->p1.x + b2 * c->p2.x + b3 * c->p3.x;
+    q->y = b0 * c->p0.y + b1 * c->p1.y + b2 * c->p2.y + b3 * c->p3.y;
+
+    // Q'(t) = 3[(1-t)²(P1-P0) + 2t(1-t)(P2-P1) + t²(P3-P2)]
+    float e0 = 3.0f * u * u, e1 = 6.0f * t * u, e2 = 3.0f * t * t;
+    d1->x = e0 * (c->p1.x - c->p0.x) + e1 * (c->p2.x - c->p1.x) + e2 * (c->p3.x - c->p2.x);
+    d1->y = e0 * (c->p1.y - c->p0.y) + e1 * (c->p2.y - c->p1.y) + e2 * (c->p3.y - c->p2.y);
+
+    // Q''(t) = 6[(1-t)(P2 - 2P1 + P0) + t(P3 - 2P2 + P1)]
+    d2->x = 6.0f * (u * (c->p2.x - 2.0f * c->p1.x + c->p0.x) + t * (c->p3.x - 2.0f * c->p2.x + c->p1.x));
+    d2->y = 6.0f * (u * (c->p2.y - 2.0f * c->p1.y + c->p0.y) + t * (c->p3.y - 2.0f * c->p2.y + c->p1.y));
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      计算点集到贝塞尔曲线的最大距离
+// 参数说明      curve         拟合得到的曲线
+// 参数说明      points        该段的点 (与拟合时相同)
+// 参数说明      count         点数
+// 参数说明      worst_index   输出：距离最大的点在 points 中的下标
+// 返回参数      float         最大距离 (像素)
+// 备注信息      t 的初值与 fit_bezier_curve 一样取弦长参数，再做 BEZIER_NEWTON_STEPS 次牛顿迭代：
+//               t ← t - (Q-P)·Q' / (Q'·Q' + (Q-P)·Q'')，结果限制在 [0, 1]。
+//-------------------------------------------------------------------------------------------------------------------
+static float bezier_segment_error(const CubicBezier *curve, const point *points, int count, int *worst_index)
+{
+    float total_length = 0;
+    for (int i = 1; i < count; i++) {
+        float dx = (float)points[i].x - (float)points[i - 1].x;
+        float dy = (float)points[i].y - (float)points[i - 1].y;
+        total_length += sqrtf(dx * dx + dy * dy);
+    }
+
+    float max_sq = 0;
+    float accumulated_length = 0;
+    *worst_index = 0;
+
+    for (int i = 1; i < count - 1; i++) { // 首尾点与曲线端点重合，误差为0
+        float dx = (float)points[i].x - (float)points[i - 1].x;
+        float dy = (float)points[i].y - (float)points[i - 1].y;
+        accumulated_length += sqrtf(dx * dx + dy * dy);
+        float t = (total_length > 0) ? accumulated_length / total_length : 0.0f;
+
+        point_f q, d1, d2;
+        bezier_eval_derivatives(curve, t, &q, &d1, &d2);
+        float ex = q.x - (float)points[i].x;
+        float ey = q.y - (float)points[i].y;
+        for (int step = 0; step < BEZIER_NEWTON_STEPS; step++) {
+            float numerator = ex * d1.x + ey * d1.y;
+            float denominator = d1.x * d1.x + d1.y * d1.y + ex * d2.x + ey * d2.y;
+            if (fabsf(denominator) < 1e-6f) {
+                break;
+            }
+            t -= numerator / denominator;
+            t = (t < 0.0f) ? 0.0f : (t > 1.0f ? 1.0f : t);
+            bezier_eval_derivatives(curve, t, &q, &d1, &d2);
+            ex = q.x - (float)points[i].x;
+            ey = q.y - (float)points[i].y;
+        }
+
+        float dist_sq = ex * ex + ey * ey;
+        if (dist_sq > max_sq) {
+            max_sq = dist_sq;
+            *worst_index = i;
+        }
+    }
+    return sqrtf(max_sq);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      拟合 [first, last] 这一段并求其误差
+// 参数说明      worst         输出：误差最大点在整条边中的下标
+//-------------------------------------------------------------------------------------------------------------------
+static void fit_bezier_segment(const point *points, uint8_t first, uint8_t last, BezierSegment *segment, uint8_t *worst)
+{
+    int count = last - first + 1;
+    int worst_local;
+
+    segment->first = first;
+    segment->last = last;
+    segment->curve = fit_bezier_curve(points + first, count);
+    segment->max_error = bezier_segment_error(&segment->curve, points + first, count, &worst_local);
+    *worst = (uint8_t)(first + worst_local);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      误差受限的分段贝塞尔拟合
+// 参数说明      points        输入的离散点数组 (filtered_edge)
+// 参数说明      count         点数
+// 参数说明      tolerance     允许的最大点到曲线距离 (像素)
+// 参数说明      result        输出：分段结果、拟合次数和最终误差
+// 返回参数      uint8_t       本次执行的单段拟合次数 (与 result->iterations 相同)，点数不足时为0
+// 备注信息      每次选误差最大、且超过容差、且还能再分的段，在其最远点处分割。分割点限制在距两端至少
+//               BEZIER_MIN_SEGMENT_POINTS - 1 个点的范围内。最多执行 2 * BEZIER_MAX_SEGMENTS - 1 次单段拟合。
+//-------------------------------------------------------------------------------------------------------------------
+uint8_t fit_bezier_piecewise(const point *points, int count, float tolerance, BezierPiecewise *result)
+{
+    uint8_t worst[BEZIER_MAX_SEGMENTS]; // 各段误差最大点的下标，与 result->segment 一一对应
+
+    result->segment_count = 0;
+    result->iterations = 0;
+    result->max_error = 0;
+    if (count < 4 || count > 255) {
+        return 0;
+    }
+
+    fit_bezier_segment(points, 0, (uint8_t)(count - 1), &result->segment[0], &worst[0]);
+    result->segment_count = 1;
+    result->iterations = 1;
+
+    while (result->segment_count < BEZIER_MAX_SEGMENTS) {
+        // 选出误差最大、且超过容差、且还能再分的段
+        int pick = -1;
+        for (int s = 0; s < result->segment_count; s++) {
+            const BezierSegment *seg = &result->segment[s];
+            if (seg->max_error > tolerance
+                && seg->last - seg->first + 1 >= 2 * BEZIER_MIN_SEGMENT_POINTS - 1
+                && (pick < 0 || seg->max_error > result->segment[pick].max_error)) {
+                pick = s;
+            }
+        }
+        if (pick < 0) {
+            break;
+        }
+
+        // 在最远点处分割，保证两段都不少于 BEZIER_MIN_SEGMENT_POINTS 个点
+        const uint8_t first = result->segment[pick].first;
+        const uint8_t last = result->segment[pick].last;
+        uint8_t split = worst[pick];
+        if (split < first + BEZIER_MIN_SEGMENT_POINTS - 1) {
+            split = first + BEZIER_MIN_SEGMENT_POINTS - 1;
+        }
+        if (split > last - BEZIER_MIN_SEGMENT_POINTS + 1) {
+            split = last - BEZIER_MIN_SEGMENT_POINTS + 1;
+        }
+
+        // 后面的段后移一位，腾出 pick + 1
+        for (int s = result->segment_count; s > pick + 1; s--) {
+            result->segment[s] = result->segment[s - 1];
+            worst[s] = worst[s - 1];
+        }
+        fit_bezier_segment(points, first, split, &result->segment[pick], &worst[pick]);
+        fit_bezier_segment(points, split, last, &result->segment[pick + 1], &worst[pick + 1]);
+        result->segment_count++;
+        result->iterations += 2;
+    }
+
+    for (int s = 0; s < result->segment_count; s++) {
+        if (result->segment[s].max_error > result->max_error) {
+            result->max_error = result->segment[s].max_error;
+        }
+    }
+    return result->iterations;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      调度左右两条边的分段贝塞尔拟合
+// 备注信息      left_bezier / right_bezier 填入最靠近车头的第一段，只有一段时与 fit_edges_with_bezier 的结果相同，
+//               只读取单条曲线的旧代码不需要修改。
+//-------------------------------------------------------------------------------------------------------------------
+void fit_edges_with_bezier_piecewise(TrackContext *context) {
+    // 拟合左边缘
+    if (context->left_edge.is_found && context->left_edge.filtered_points_count >= 4) {
+        fit_bezier_piecewise(context->left_edge.filtered_edge, context->left_edge.filtered_points_count,
+                             BEZIER_FIT_TOLERANCE, &context->left_pieces);
+    } else {
+        context->left_pieces.segment_count = 0;
+    }
+    context->left_bezier_found = (context->left_pieces.segment_count > 0);
+    if (context->left_bezier_found) {
+        context->left_bezier = context->left_pieces.segment[0].curve;
+    }
+
+    // 拟合右边缘
+    if (context->right_edge.is_found && context->right_edge.filtered_points_count >= 4) {
+        fit_bezier_piecewise(context->right_edge.filtered_edge, context->right_edge.filtered_points_count,
+                             BEZIER_FIT_TOLERANCE, &context->right_pieces);
+    } else {
+        context->right_pieces.segment_count = 0;
+    }
+    context->right_bezier_found = (context->right_pieces.segment_count > 0);
+    if (context->right_bezier_found) {
+        context->right_bezier = context->right_pieces.segment[0].curve;
+    }
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（分段贝塞尔版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      每条边的拟合次数和最终误差在 left_pieces / right_pieces 中，可逐帧观察精度与耗时的取舍。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 分段曲线拟合 ---
+    fit_edges_with_bezier_piecewise(context);
+}
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 均匀参数贝塞尔拟合
+// fit_bezier_curve 用弦长参数化，每个点一次 sqrtf、一次除法和4个基函数，而这些对每帧都要重算。
+// filtered_edge 每行一个点，若把边缘按行均匀重采样为 N 个点并取 t_k = k / (N - 1)，基函数矩阵只与 N 有关：
+// 1. 最小二乘解 P1 = Σ a_k·(d_k - B0(t_k)·P0 - B3(t_k)·P3)，其中 a_k 由 2x2 法方程的逆矩阵与 B1、B2 得到。
+//    首尾点就是 d_0 和 d_{N-1}，把含 P0、P3 的两项并入首尾权值后 P1 = Σ w1[k]·d_k，P2 同理 (权值和均为1)。
+// 2. 对称性：t → 1 - t 时 B1、B2 互换，所以 w2[k] = w1[N-1-k]，每个 N 只需存一张表。
+// 3. 权值表由 bezier_uniform_build_weights 在电脑上用双精度算出，以 const 数组存放 (N = 8/16/32 共 56 个 float)，
+//    MCU 上拟合只剩重采样和两组点积，没有开方、除法和基函数计算。
+// 注意参数 t 与行号成正比而不是与弧长成正比，边缘很“横” (每行 x 变化很大) 时精度不如弦长参数化。
+//-------------------------------------------------------------------------------------------------------------------
+#define BEZIER_PARAM_CHORD   0 // 弦长参数化 (fit_bezier_curve)
+#define BEZIER_PARAM_UNIFORM 1 // 按行均匀重采样 + 预计算权值表
+
+#define BEZIER_PARAM_MODE BEZIER_PARAM_UNIFORM
+
+CubicBezier fit_bezier_curve(const point* points, int count); // 弦长参数化拟合，实现见 image_processing_04.c
+
+// 各 N 对应的 P1 权值 w1[k] (P2 的权值为 w1[N-1-k])
+static const float bezier_uniform_w1_8[8] = {
+    -1.208641975f, +1.057201646f, +1.173868313f, +0.702880658f, -0.002880658f, -0.590534979f, -0.707201646f, +0.575308642f
+};
+static const float bezier_uniform_w1_16[16] = {
+    -1.304283699f, +0.293240613f, +0.472658763f, +0.554853901f, +0.556425474f, +0.493972932f, +0.384095724f, +0.243393300f,
+    +0.088465108f, -0.064089403f, -0.197670783f, -0.295679582f, -0.341516353f, -0.318581646f, -0.210276011f, +0.644991663f
+};
+static const float bezier_uniform_w1_32[32] = {
+    -1.326428435f, +0.076014940f, +0.138169581f, +0.187373506f, +0.224536298f, +0.250567540f, +0.266376815f, +0.272873706f,
+    +0.270967797f, +0.261568670f, +0.245585909f, +0.223929096f, +0.197507815f, +0.167231648f, +0.134010180f, +0.098752992f,
+    +0.062369669f, +0.025769792f, -0.010137054f, -0.044441287f, -0.076233323f, -0.104603580f, -0.128642475f, -0.147440423f,
+    -0.160087843f, -0.165675152f, -0.163292765f, -0.152031100f, -0.130980575f, -0.099231605f, -0.055874608f, +0.661494270f
+};
+
+typedef struct {
+    uint8_t      n;  // 重采样点数
+    const float *w1; // P1 的权值表
+} BezierUniformTable;
+
+// 按 N 从大到小排列，拟合时选不超过点数的最大 N
+static const BezierUniformTable bezier_uniform_tables[] = {
+    {32, bezier_uniform_w1_32},
+    {16, bezier_uniform_w1_16},
+    { 8, bezier_uniform_w1_8},
+};
+#define BEZIER_UNIFORM_TABLE_COUNT (sizeof(bezier_uniform_tables) / sizeof(bezier_uniform_tables[0]))
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      计算 N 点均匀参数拟合的 P1 权值表
+// 参数说明      n             重采样点数 (>= 4)
+// 参数说明      w1            输出 n 个权值
+// 备注信息      在电脑上运行并打印结果即可得到上面的 const 表，增加新的 N 时使用；MCU 上不需要编译。
+//-------------------------------------------------------------------------------------------------------------------
+#ifdef BEZIER_UNIFORM_GENERATOR
+void bezier_uniform_build_weights(int n, double *w1)
+{
+    double c00 = 0, c01 = 0, c11 = 0; // 法方程矩阵 Σ[B1B1 B1B2; B1B2 B2B2]
+    for (int k = 0; k < n; k++) {
+        double t = (double)k / (n - 1), u = 1.0 - t;
+        double b1 = 3.0 * t * u * u, b2 = 3.0 * t * t * u;
+        c00 += b1 * b1;
+        c01 += b1 * b2;
+        c11 += b2 * b2;
+    }
+    double det = c00 * c11 - c01 * c01;
+    double i00 = c11 / det, i01 = -c01 / det; // 逆矩阵第一行
+
+    double s0 = 0, s3 = 0; // Σ a_k·B0(t_k)、Σ a_k·B3(t_k)
+    for (int k = 0; k < n; k++) {
+        double t = (double)k / (n - 1), u = 1.0 - t;
+        w1[k] = i00 * 3.0 * t * u * u + i01 * 3.0 * t * t * u;
+        s0 += w1[k] * u * u * u;
+        s3 += w1[k] * t * t * t;
+    }
+    w1[0] -= s0;     // 把 -B0·P0 一项并入首点
+    w1[n - 1] -= s3; // 把 -B3·P3 一项并入末点
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      按行均匀重采样后用预计算权值拟合三阶贝塞尔曲线
+// 参数说明      points        输入的离散点数组 (filtered_edge，每行一个点)
+// 参数说明      count         输入的点的数量
+// 返回参数      CubicBezier   计算得到的贝塞尔曲线，P0、P3 为首尾点
+// 备注信息      选不超过 count 的最大 N，第 k 个样本取下标 round(k·(count-1)/(N-1))，用 Q16 步长累加，整帧一次除法。
+//               点数少于最小的 N 时退回 fit_bezier_curve。
+//-------------------------------------------------------------------------------------------------------------------
+CubicBezier fit_bezier_curve_uniform(const point* points, int count) {
+    const BezierUniformTable *table = NULL;
+    for (unsigned i = 0; i < BEZIER_UNIFORM_TABLE_COUNT; i++) {
+        if (bezier_uniform_tables[i].n <= count) {
+            table = &bezier_uniform_tables[i];
+            break;
+        }
+    }
+    if (table == NULL) {
+        return fit_bezier_curve(points, count);
+    }
+
+    const int n = table->n;
+    const float *w1 = table->w1;
+    const uint32_t step = ((uint32_t)(count - 1) << 16) / (uint32_t)(n - 1); // 采样下标步长 (Q16)
+    uint32_t position = 1u << 15;                                             // +0.5 用于四舍五入
+
+    point_f p1 = {0, 0}, p2 = {0, 0};
+    for (int k = 0; k < n; k++) {
+        const point p = points[(k == n - 1) ? count - 1 : (int)(position >> 16)]; // 末点直接取，避免步长截断误差
+        const float x = (float)p.x, y = (float)p.y;
+        const float a = w1[k];
+        const float b = w1[n - 1 - k]; // P2 的权值
+        p1.x += a * x;
+        p1.y += a * y;
+        p2.x += b * x;
+        p2.y += b * y;
+        position += step;
+    }
+
+    CubicBezier bezier;
+    bezier.p0 = (point_f){(float)points[0].x, (float)points[0].y};
+    bezier.p1 = p1;
+    bezier.p2 = p2;
+    bezier.p3 = (point_f){(float)points[count - 1].x, (float)points[count - 1].y};
+    return bezier;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      调度左右两条边的均匀参数贝塞尔拟合
+//-------------------------------------------------------------------------------------------------------------------
+void fit_edges_with_bezier_uniform(TrackContext *context) {
+    // 拟合左边缘
+    if (context->left_edge.is_found && context->left_edge.filtered_points_count >= 4) {
+        context->left_bezier = fit_bezier_curve_uniform(context->left_edge.filtered_edge,
+                                                        context->left_edge.filtered_points_count);
+        context->left_bezier_found = true;
+    } else {
+        context->left_bezier_found = false;
+    }
+
+    // 拟合右边缘
+    if (context->right_edge.is_found && context->right_edge.filtered_points_count >= 4) {
+        context->right_bezier = fit_bezier_curve_uniform(context->right_edge.filtered_edge,
+                                                         context->right_edge.filtered_points_count);
+        context->right_bezier_found = true;
+    } else {
+        context->right_bezier_found = false;
+    }
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（均匀参数拟合版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      BEZIER_PARAM_MODE 选择拟合方式，两种方式输出格式相同。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 ---
+    binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+
+    if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+        return;
+    }
+    adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+    // --- 3. 执行阶段 ---
+    search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+
+    // --- 4. 结果处理阶段 ---
+    context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+    context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                               context->left_edge.raw_points_count + 1,
+                                                                               context->left_edge.mapped_edge);
+    context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                context->right_edge.raw_points_count + 1,
+                                                                                context->right_edge.mapped_edge);
+    extract_and_filter_edges_fused(context);
+
+    // --- 5. 曲线拟合阶段 ---
+#if BEZIER_PARAM_MODE == BEZIER_PARAM_UNIFORM
+    fit_edges_with_bezier_uniform(context);
+#else
+    fit_edges_with_bezier(context);
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,585 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+#include "image_kernels.h" // 行扫描内核 (Cortex-M4 上使用 DSP 指令)
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+static BinaryFrame binary_frame; // 本帧的压缩二值图
+
+//-------------------------------------------------------------------------------------------------------------------
+// 由粗到细的金字塔循迹
+// 全分辨率逐像素轮廓跟踪是最耗时的阶段。金字塔模式：
+// 1. 二值化时顺带生成 2 倍下采样的 94x60 压缩帧：相邻两行的位掩码按位与，再把每两个相邻位与成一位，
+//    即 2x2 全白才为白 (细小的白噪点在粗帧中消失)。每两行只多十几次位运算，不再读取灰度图。
+// 2. 在粗帧上做起点搜索和轮廓跟踪 (逻辑与 get_start_point_packed / search_line_packed 相同)，步数约为全分辨率的一半。
+// 3. 粗边界 X 对应全分辨率的 2X 附近，每一行只在 ±PYRAMID_BAND 的窄带内按 img_mask_find_transition 的方法找
+//    “黑黑白白” (左) / “白白黑黑” (右) 跳变，直接写入 mapped_edge，之后与游程引擎一样交给 extract_and_filter_edges_fused。
+// 4. 窄带内找不到跳变、估计点又不在水平边界上，说明粗细两层不一致 (细边界在粗帧里被抹掉、噪点等)，
+//    这样的行超过 PYRAMID_MAX_MISSES 或粗帧找不到起点时，本帧退回全分辨率循迹。pyramid_enabled 可以逐帧切换。
+// 金字塔模式只生成行地图，raw_edge_points / raw_direction 不再填写，依赖链码的阶段需要关闭金字塔模式。
+//-------------------------------------------------------------------------------------------------------------------
+#define COARSE_W         (IMAGE_W / 2)            // 粗帧宽度 (94)
+#define COARSE_H         (IMAGE_H / 2)            // 粗帧高度 (60)
+#define COARSE_ROW_WORDS ((COARSE_W + 31) / 32)   // 粗帧每行的字数 (3)
+
+#define PYRAMID_BAND       5 // 细化窄带半宽 (全分辨率像素)
+#define PYRAMID_MAX_MISSES 4 // 窄带内找不到跳变的行数超过该值时退回全分辨率
+
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u // 可映射到 DWT->CYCCNT 以统计耗时
+#endif
+
+typedef struct {
+    uint32_t row[COARSE_H][COARSE_ROW_WORDS]; // 位格式与 BinaryFrame 相同
+} CoarseFrame;
+
+#define COARSE_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+typedef struct {
+    uint32_t trace_cycles;  // 起点搜索 + 循迹 (+ 细化) 耗时 (周期)
+    uint16_t coarse_steps;  // 粗帧循迹步数
+    uint8_t  refined_rows;  // 细化的行数 (左右合计)
+    uint8_t  misses;        // 窄带内找不到跳变的行数
+    bool     fell_back;     // 本帧是否退回全分辨率
+} PyramidStats;
+
+static CoarseFrame  coarse_frame;                  // 本帧的粗帧
+static EdgeTracker  coarse_left, coarse_right;     // 粗帧上的循迹结果 (粗帧坐标)
+static bool         pyramid_enabled = true;        // 每帧可单独修改，false 时完全走全分辨率路径
+static PyramidStats pyramid_stats;                 // 最近一帧的统计
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      取出32位字的偶数位，压缩到低16位
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t compact_even_bits(uint32_t x)
+{
+    x &= 0x55555555u;
+    x = (x | (x >> 1)) & 0x33333333u;
+    x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+    x = (x | (x >> 4)) & 0x00FF00FFu;
+    x = (x | (x >> 8)) & 0x0000FFFFu;
+    return x;
+}
+
+static inline uint8_t ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      二值化压缩，同时生成 2 倍下采样的粗帧
+// 参数说明      image         灰度图像数据指针
+// 参数说明      threshold     二值化阈值，像素值 > threshold 记为白
+// 参数说明      frame         输出的全分辨率压缩二值图，与 binarize_and_pack 的结果完全相同
+// 参数说明      coarse        输出的粗帧，第 (X, Y) 个像素为全分辨率 2x2 块 (2X..2X+1, 2Y..2Y+1) 的与
+// 备注信息      两行刚生成的位掩码还在寄存器/缓存中时就合成粗行，粗帧的填充位也为0。
+//-------------------------------------------------------------------------------------------------------------------
+void binarize_and_pack_pyramid(const uint8_t *image, uint8_t threshold, BinaryFrame *frame, CoarseFrame *coarse)
+{
+    frame->threshold = threshold;
+
+    for (int y = 0; y < IMAGE_H; y += 2)
+    {
+        uint32_t *r0 = frame->row[y];
+        uint32_t *r1 = frame->row[y + 1];
+        img_row_gt_mask(image + y * IMAGE_W, IMAGE_W, threshold, r0);
+        img_row_gt_mask(image + (y + 1) * IMAGE_W, IMAGE_W, threshold, r1);
+
+        // 每两个全分辨率字合成一个粗字：先纵向与，再把偶数位与其右邻 (奇数位) 相与后压缩
+        for (int i = 0; i < COARSE_ROW_WORDS; i++)
+        {
+            uint32_t v0 = r0[2 * i] & r1[2 * i];
+            uint32_t v1 = r0[2 * i + 1] & r1[2 * i + 1];
+            coarse->row[y >> 1][i] = compact_even_bits(v0 & (v0 >> 1)) | (compact_even_bits(v1 & (v1 >> 1)) << 16);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      带边界检查的粗帧像素读取，图像外一律视为黑色
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t coarse_pixel_checked(const CoarseFrame *frame, uint8_t x, uint8_t y)
+{
+    if (x >= COARSE_W || y >= COARSE_H)
+    {
+        return 0;
+    }
+    return COARSE_PIXEL(frame, x, y);
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在粗帧中从下向上搜索赛道左右边界的起始点
+// 备注信息      逻辑与 get_start_point_packed 相同，宽度校验按比例减半。
+//-------------------------------------------------------------------------------------------------------------------
+static bool get_start_point_coarse(const CoarseFrame *frame, point *p_left, point *p_right)
+{
+    uint32_t black[COARSE_ROW_WORDS];
+    int16_t x;
+
+    for (int y = COARSE_H - 2; y > 0; y--)
+    {
+        const uint32_t *white = frame->row[y];
+        bool l_found = false;
+        bool r_found = false;
+
+        for (int i = 0; i < COARSE_ROW_WORDS; i++)
+        {
+            black[i] = ~white[i];
+        }
+        black[COARSE_ROW_WORDS - 1] &= (1u << (COARSE_W & 31)) - 1u;
+
+        if (COARSE_PIXEL(frame, 1, y) && COARSE_PIXEL(frame, 2, y))
+        {
+            l_found = true;
+            p_left->x = 1;
+            p_left->y = y;
+        }
+        if (COARSE_PIXEL(frame, COARSE_W - 2, y) && COARSE_PIXEL(frame, COARSE_W - 3, y))
+        {
+            r_found = true;
+            p_right->x = COARSE_W - 2;
+            p_right->y = y;
+        }
+
+        if (!l_found && (x = img_mask_find_transition(black, white, 1, COARSE_W - 4)) >= 0)
+        {
+            l_found = true;
+            p_left->x = (uint8_t)x;
+            p_left->y = y;
+        }
+        if (!r_found && (x = img_mask_find_transition(white, black, 1, COARSE_W - 4)) >= 0)
+        {
+            r_found = true;
+            p_right->x = (uint8_t)x;
+            p_right->y = y;
+        }
+
+        if (l_found && r_found && (p_right->x - p_left->x) > 5)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      单步边缘跟踪（粗帧版本）
+// 备注信息      搜索顺序与 trace_single_step_packed 完全相同。
+//-------------------------------------------------------------------------------------------------------------------
+static bool trace_single_step_coarse(const CoarseFrame *frame, EdgeTracker *tracker)
+{
+    if (tracker->raw_points_count >= MAX_EDGE_POINTS - 1) {
+        tracker->is_active = false;
+        return false;
+    }
+
+    uint8_t prev_direction = tracker->raw_direction[tracker->raw_points_count];
+
+    for (int i = -1; i <= 6; i++)
+    {
+        uint8_t dir0 = (prev_direction + i + 8) & 7;
+        uint8_t dir1 = (prev_direction + i + 1 + 8) & 7;
+
+        uint8_t a0_x = tracker->current_point.x + tracker->grow_table[dir0].x;
+        uint8_t a0_y = tracker->current_point.y + tracker->grow_table[dir0].y;
+        uint8_t a1_x = tracker->current_point.x + tracker->grow_table[dir1].x;
+        uint8_t a1_y = tracker->current_point.y + tracker->grow_table[dir1].y;
+
+        // 黑 → 白 跳变
+        if (!coarse_pixel_checked(frame, a0_x, a0_y) && coarse_pixel_checked(frame, a1_x, a1_y))
+        {
+            tracker->raw_points_count++;
+            tracker->raw_direction[tracker->raw_points_count] = dir1;
+            tracker->current_point.x += tracker->grow_table[dir1].x;
+            tracker->current_point.y += tracker->grow_table[dir1].y;
+            tracker->raw_edge_points[tracker->raw_points_count] = tracker->current_point;
+            return true;
+        }
+    }
+
+    tracker->is_active = false;
+    return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      执行左右双边循迹（粗帧版本）
+// 备注信息      调度策略与 search_line_packed 相同，两边相遇的判定距离按比例减半。
+//-------------------------------------------------------------------------------------------------------------------
+static void search_line_coarse(const CoarseFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations)
+{
+    left_tracker->raw_points_count = 0;
+    left_tracker->current_point = left_tracker->start_point;
+    left_tracker->raw_edge_points[0] = left_tracker->start_point;
+    left_tracker->raw_direction[0] = 0;
+    left_tracker->is_active = true;
+
+    right_tracker->raw_points_count = 0;
+    right_tracker->current_point = right_tracker->start_point;
+    right_tracker->raw_edge_points[0] = right_tracker->start_point;
+    right_tracker->raw_direction[0] = 0;
+    right_tracker->is_active = true;
+
+    while (max_iterations-- > 0 && (left_tracker->is_active || right_tracker->is_active))
+    {
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (left_tracker->current_point.y >= right_tracker->current_point.y) {
+                trace_single_step_coarse(frame, left_tracker);
+            } else {
+                trace_single_step_coarse(frame, right_tracker);
+            }
+        } else if (left_tracker->is_active) {
+            trace_single_step_coarse(frame, left_tracker);
+        } else if (right_tracker->is_active) {
+            trace_single_step_coarse(frame, right_tracker);
+        }
+
+        if (left_tracker->is_active && right_tracker->is_active) {
+            if (abs(left_tracker->current_point.x - right_tracker->current_point.x) < 3 &&
+                abs(left_tracker->current_point.y - right_tracker->current_point.y) < 3) {
+                break;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      取出压缩行中从 x 开始的32个像素
+// 备注信息      跨字时拼接相邻两个字，超出行尾的位为0 (黑)。
+//-------------------------------------------------------------------------------------------------------------------
+static inline uint32_t bin_row_window(const uint32_t *row, int x)
+{
+    const int word = x >> 5;
+    const int shift = x & 31;
+    uint32_t bits = row[word] >> shift;
+    if (shift != 0 && word + 1 < BIN_ROW_WORDS)
+    {
+        bits |= row[word + 1] << (32 - shift);
+    }
+    return bits;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      在全分辨率窄带内细化一条边的一行
+// 参数说明      frame         全分辨率压缩二值图
+// 参数说明      y             全分辨率行号
+// 参数说明      coarse_x      粗帧在该行的边界 X (粗帧坐标)
+// 参数说明      polarity      左边缘找“黑黑白白”，右边缘找“白白黑黑”
+// 参数说明      out_x         输出全分辨率边界 x (紧贴黑色的白像素，与轮廓跟踪的定义相同)
+// 返回参数      bool          窄带内找到跳变、粗边界贴着图像边框或估计点落在水平边界上返回true，否则返回false
+// 备注信息      窄带连同模式长度不超过 2 * PYRAMID_BAND + 4 位，一次取出32位窗口后与 img_mask_find_transition
+//               一样用移位相与找模式，但只有一个字，不需要逐字循环。
+//-------------------------------------------------------------------------------------------------------------------
+static bool refine_row_in_band(const BinaryFrame *frame, uint8_t y, uint8_t coarse_x, EdgePolarity polarity, uint8_t *out_x)
+{
+    int from, to;
+
+    if (polarity == EDGE_LEFT)
+    {
+        if (coarse_x <= 1)
+        {
+            *out_x = 1; // 贴左边框，与全分辨率循迹沿边框走出的 x 相同
+            return true;
+        }
+        // 左边界 (第一个白点) = 跳变起点 + 2，落在 [2X - BAND, 2X + BAND]
+        from = 2 * coarse_x - PYRAMID_BAND - 2;
+        to = 2 * coarse_x + PYRAMID_BAND - 2;
+    }
+    else
+    {
+        if (coarse_x >= COARSE_W - 2)
+        {
+            *out_x = IMAGE_W - 2;
+            return true;
+        }
+        // 右边界 (最后一个白点) = 跳变起点 + 1，落在 [2X + 1 - BAND, 2X + 1 + BAND]
+        from = 2 * coarse_x - PYRAMID_BAND;
+        to = 2 * coarse_x + PYRAMID_BAND;
+    }
+    from = (from < 1) ? 1 : from;
+    to = (to > IMAGE_W - 4) ? IMAGE_W - 4 : to;
+
+    // 第 i 位为1 ⇔ 起点 from + i 处满足 a,a,b,b
+    const uint32_t w = bin_row_window(frame->row[y], from);
+    const uint32_t a = (polarity == EDGE_LEFT) ? ~w : w;
+    const uint32_t b = ~a;
+    uint32_t match = a & (a >> 1) & (b >> 2) & (b >> 3);
+    match &= (2u << (to - from)) - 1u; // 只保留起点在 [from, to] 内的位
+
+    if (match == 0)
+    {
+        // 没有水平方向的跳变：粗轮廓在这一行沿水平边界行走 (十字路口的横向白带等)。粗帧一行对应两行，
+        // 再加上 2x2 与运算的腐蚀，细边界最多偏开2行，估计点白且上下2行内有黑点即认为一致
+        const uint8_t x = (uint8_t)(2 * coarse_x + polarity);
+        *out_x = x;
+        if (!BIN_PIXEL(frame, x, y))
+        {
+            return false;
+        }
+        for (int dy = 1; dy <= 2; dy++)
+        {
+            if ((y >= dy && !BIN_PIXEL(frame, x, y - dy)) || (y + dy < IMAGE_H && !BIN_PIXEL(frame, x, y + dy)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    *out_x = (uint8_t)(from + ctz32(match) + 2 - polarity); // EDGE_LEFT = 0, EDGE_RIGHT = 1
+    return true;
+}
+
+uint8_t convert_edge_to_row_map_first_point(const point *input, int size, uint8_t *output); // 实现见 image_processing_03.c
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+void binarize_and_pack(const uint8_t *image, uint8_t threshold, BinaryFrame *frame); // 实现见 image_processing_05.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void search_line_packed(const BinaryFrame *frame, EdgeTracker *left_tracker, EdgeTracker *right_tracker, uint16_t max_iterations); // 实现见 image_processing_05.c
+void adjust_start_point_for_trace(point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      粗帧循迹 + 全分辨率窄带细化，直接生成左右行地图
+// 参数说明      frame         全分辨率压缩二值图
+// 参数说明      coarse        粗帧
+// 参数说明      context       输出 left_edge / right_edge 的 mapped_edge、mapped_edge_start_y、mapped_edge_end_y
+// 返回参数      bool          成功返回true；粗帧找不到起点或不一致的行过多时返回false，调用者应退回全分辨率循迹
+// 备注信息      粗帧第 Y 行对应全分辨率的 2Y、2Y+1 两行，未写入的行保持为0。
+//-------------------------------------------------------------------------------------------------------------------
+bool trace_pyramid(const BinaryFrame *frame, const CoarseFrame *coarse, TrackContext *context)
+{
+    EdgeTracker *left_edge = &context->left_edge;
+    EdgeTracker *right_edge = &context->right_edge;
+
+    pyramid_stats.coarse_steps = 0;
+    pyramid_stats.refined_rows = 0;
+    pyramid_stats.misses = 0;
+
+    // --- 1. 粗帧起点搜索与循迹 ---
+    coarse_left.grow_table = grow_l;
+    coarse_right.grow_table = grow_r;
+    if (!get_start_point_coarse(coarse, &coarse_left.start_point, &coarse_right.start_point))
+    {
+        return false;
+    }
+    // 起点搜索返回的是跳变模式的起点，循迹从紧贴边界的黑点出发：左边为“黑黑白白”的第二个黑点，
+    // 右边为“白白黑黑”的第一个黑点 (贴边框的情况起点已在边框上)
+    if (coarse_left.start_point.x > 1)
+    {
+        coarse_left.start_point.x += 1;
+    }
+    if (coarse_right.start_point.x < COARSE_W - 2)
+    {
+        coarse_right.start_point.x += 2;
+    }
+    search_line_coarse(coarse, &coarse_left, &coarse_right, MAX_EDGE_POINTS * 2);
+    pyramid_stats.coarse_steps = coarse_left.raw_points_count + coarse_right.raw_points_count;
+
+    const uint8_t start_y = coarse_left.start_point.y;
+    const uint8_t left_end = convert_edge_to_row_map_first_point(coarse_left.raw_edge_points, coarse_left.raw_points_count + 1,
+                                                                 coarse_left.mapped_edge);
+    const uint8_t right_end = convert_edge_to_row_map_first_point(coarse_right.raw_edge_points, coarse_right.raw_points_count + 1,
+                                                                  coarse_right.mapped_edge);
+
+    // --- 2. 逐行在窄带内细化 ---
+    memset(left_edge->mapped_edge, 0, IMAGE_H);
+    memset(right_edge->mapped_edge, 0, IMAGE_H);
+    const uint8_t top = (left_end < right_end) ? left_end : right_end;
+
+    for (int y = 2 * start_y + 1; y >= 2 * top; y--)
+    {
+        const uint8_t cy = (uint8_t)(y >> 1);
+        if (cy >= left_end && coarse_left.mapped_edge[cy] != 0)
+        {
+            pyramid_stats.misses += !refine_row_in_band(frame, (uint8_t)y, coarse_left.mapped_edge[cy], EDGE_LEFT,
+                                                        &left_edge->mapped_edge[y]);
+            pyramid_stats.refined_rows++;
+        }
+        if (cy >= right_end && coarse_right.mapped_edge[cy] != 0)
+        {
+            pyramid_stats.misses += !refine_row_in_band(frame, (uint8_t)y, coarse_right.mapped_edge[cy], EDGE_RIGHT,
+                                                        &right_edge->mapped_edge[y]);
+            pyramid_stats.refined_rows++;
+        }
+    }
+    if (pyramid_stats.misses > PYRAMID_MAX_MISSES)
+    {
+        return false;
+    }
+
+    // --- 3. 与全分辨率循迹相同的输出约定 ---
+    left_edge->mapped_edge_start_y = right_edge->mapped_edge_start_y = (uint8_t)(2 * start_y + 1);
+    left_edge->mapped_edge_end_y = (uint8_t)(2 * left_end);
+    right_edge->mapped_edge_end_y = (uint8_t)(2 * right_end);
+    left_edge->start_point = (point){left_edge->mapped_edge[2 * start_y + 1], (uint8_t)(2 * start_y + 1)};
+    right_edge->start_point = (point){right_edge->mapped_edge[2 * start_y + 1], (uint8_t)(2 * start_y + 1)};
+    left_edge->raw_points_count = 0; // 金字塔模式不生成链码
+    right_edge->raw_points_count = 0;
+    return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（金字塔版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      pyramid_enabled 为 false 或金字塔细化失败时走全分辨率路径，两条路径输出相同格式的行地图；
+//               循迹阶段 (含起点搜索) 的耗时记录在 pyramid_stats.trace_cycles 中，便于逐帧对比。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+    // --- 1. 配置阶段 ---
+    context->left_edge.threshold = 128;  // 示例阈值
+    context->right_edge.threshold = 128;
+
+    // --- 2. 二值化压缩 (金字塔模式下同时生成粗帧) ---
+    if (pyramid_enabled) {
+        binarize_and_pack_pyramid(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame, &coarse_frame);
+    } else {
+        binarize_and_pack(mt9v03x_image_copy[0], context->left_edge.threshold, &binary_frame);
+    }
+
+    // --- 3. 执行阶段：先试金字塔，失败时退回全分辨率 ---
+    uint32_t t0 = IMAGE_CYCLE_COUNTER();
+    pyramid_stats.fell_back = false;
+    if (pyramid_enabled && trace_pyramid(&binary_frame, &coarse_frame, context)) {
+        pyramid_stats.trace_cycles = IMAGE_CYCLE_COUNTER() - t0;
+        extract_and_filter_edges_fused(context);
+    } else {
+        pyramid_stats.fell_back = pyramid_enabled;
+        if (!get_start_point_packed(&binary_frame, &context->left_edge.start_point, &context->right_edge.start_point)) {
+            return;
+        }
+        adjust_start_point_for_trace(&context->left_edge.start_point, &context->right_edge.start_point);
+        search_line_packed(&binary_frame, &context->left_edge, &context->right_edge, MAX_EDGE_POINTS * 2);
+        pyramid_stats.trace_cycles = IMAGE_CYCLE_COUNTER() - t0;
+        context->left_edge.mapped_edge_start_y = context->right_edge.mapped_edge_start_y = context->left_edge.start_point.y;
+        context->left_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->left_edge.raw_edge_points,
+                                                                                   context->left_edge.raw_points_count + 1,
+                                                                                   context->left_edge.mapped_edge);
+        context->right_edge.mapped_edge_end_y = convert_edge_to_row_map_first_point(context->right_edge.raw_edge_points,
+                                                                                    context->right_edge.raw_points_count + 1,
+                                                                                    context->right_edge.mapped_edge);
+        extract_and_filter_edges_fused(context);
+    }
+
+    // --- 4. 曲线拟合阶段 ---
+    fit_edges_with_bezier(context);
+}
\ No newline at end of file
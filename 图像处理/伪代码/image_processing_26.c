@@ -0,0 +1,490 @@
+#include "stdint.h"
+#include <stdbool.h>
+#include <string.h> // 为 memset 添加头文件
+#include <stdlib.h> // 为 abs 添加头文件
+#include <math.h>// 用于 powf 和 sqrtf
+#include "image_kernels.h" // 行扫描内核 (Cortex-M4 上使用 DSP 指令)
+
+#define IMAGE_W 188         // 图像处理宽度（像素）
+#define IMAGE_H 120         // 图像处理高度（像素）
+#define IMAGE_WHITE    255  //白色
+#define IMAGE_BLACK    0    //黑色
+#define MAX_EDGE_POINTS 240 //最大边缘点数
+// 使用枚举类型来明确表示左右边缘，增强代码可读性和类型安全
+typedef enum {
+    EDGE_LEFT = 0,
+    EDGE_RIGHT = 1
+} EdgePolarity;
+
+typedef struct {
+    uint8_t x;  // X坐标
+    uint8_t y;  // Y坐标
+} point;
+// 用于浮点数计算的点结构体，避免精度损失
+typedef struct {
+    float x;
+    float y;
+} point_f;
+// 用于存储三阶贝塞尔曲线四个控制点的结构体
+typedef struct {
+    point_f p0, p1, p2, p3;
+} CubicBezier;
+// 边缘生长方向结构体
+typedef struct {
+    int8_t x;  // x方向增量
+    int8_t y;  // y方向增量
+} grow;
+
+/* 左边界搜索方向表（顺时针方向）*/
+static grow grow_l[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {1,-1},  // 1: 右上 ↗
+    {1,0},   // 2: 右移 →
+    {1,1},   // 3: 右下 ↘
+    {0,1},   // 4: 下移 ↓
+    {-1,1},  // 5: 左下 ↙
+    {-1,0},  // 6: 左移 ←
+    {-1,-1}  // 7: 左上 ↖
+};
+
+/* 右边界搜索方向表（逆时针方向）*/
+static grow grow_r[8] = {
+    {0,-1},  // 0: 上移 ↑
+    {-1,-1}, // 1: 左上 ↖
+    {-1,0},  // 2: 左移 ←
+    {-1,1},  // 3: 左下 ↙
+    {0,1},   // 4: 下移 ↓
+    {1,1},   // 5: 右下 ↘
+    {1,0},   // 6: 右移 →
+    {1,-1}   // 7: 右上 ↗
+};
+typedef struct {
+    // 原始循迹数据 (来自 search_lr_line)
+    // --- 配置参数 ---
+    point       start_point;
+    const grow* grow_table;
+    uint8_t     threshold;
+    // --- 结果存储 (数组内嵌) ---
+    point    raw_edge_points[MAX_EDGE_POINTS];
+    uint8_t  raw_direction[MAX_EDGE_POINTS];
+    uint16_t raw_points_count;
+    // --- 实时状态 ---
+    point           current_point;
+    bool            is_active;
+
+    // 中间数据 (来自 convert_edge_to_row_map)
+    uint8_t mapped_edge[IMAGE_H];
+    uint8_t mapped_edge_start_y;
+    uint8_t mapped_edge_end_y;
+
+    // 结果数据 (来自 extract_single_edge)
+    point   filtered_edge[IMAGE_H];
+    int     filtered_points_count;
+
+    // 状态标志
+    bool    breakpoint_flag;
+    bool    is_found;
+    
+    // 新增的弯心成员
+    point   turn_center;
+    int16_t max_deviation;
+    bool    is_turn_found;
+} EdgeTracker;
+
+// 中线每一行的来源
+typedef enum {
+    MID_SOURCE_NONE = 0, // 该行没有中线
+    MID_SOURCE_BOTH,     // 左右边缘取平均
+    MID_SOURCE_LEFT,     // 只有左边缘，按赛道宽度表向右补半宽
+    MID_SOURCE_RIGHT     // 只有右边缘，按赛道宽度表向左补半宽
+} MidSource;
+
+#define MID_FRAC_BITS 4 // 中线与赛道宽度的定点小数位数 (Q4，1/16 像素)
+
+// 中线结果，所有数组按行号索引
+typedef struct {
+    int16_t mid[IMAGE_H];      // 中线 x (Q4)，单边补线时可能超出图像
+    uint8_t source[IMAGE_H];   // MidSource
+    uint8_t start_y;           // 中线最底行
+    uint8_t end_y;             // 中线最高行
+    uint8_t valid_rows;        // source 不为 NONE 的行数
+    int16_t steering_error;    // 加权偏差 (Q4 像素)，中线在图像中心右侧为正
+    bool    is_found;          // 本帧偏差是否有效，无效时 steering_error 保持上一帧的值
+} MidLine;
+
+// 最高层的数据上下文，封装了左右两条边以及其他全局状态
+typedef struct {
+    EdgeTracker left_edge;
+    EdgeTracker right_edge;
+    // 贝塞尔曲线结果
+    CubicBezier left_bezier;
+    CubicBezier right_bezier;
+    bool left_bezier_found;
+    bool right_bezier_found;
+    // 其他可能需要的全局状态可以放在这里
+    uint8_t final_distance;
+
+    // 新增的中线成员
+    MidLine mid_line;
+} TrackContext;
+
+// 1bpp 压缩二值图：每行 188 个像素占用 6 个 32 位字 (192 位)，整帧 120*6*4 = 2880 字节，
+// 相比 8 位灰度图的 22560 字节减少约 87%。第 y 行第 x 个像素存放在 row[y][x >> 5] 的第 (x & 31) 位，1 为白。
+#define BIN_ROW_WORDS ((IMAGE_W + 31) / 32)
+
+typedef struct {
+    uint32_t row[IMAGE_H][BIN_ROW_WORDS];
+    uint8_t  threshold; // 生成该帧时使用的阈值
+} BinaryFrame;
+
+// 读取压缩帧中 (x, y) 处的像素，白色返回1，黑色返回0
+#define BIN_PIXEL(frame, x, y) (((frame)->row[(y)][(x) >> 5] >> ((x) & 31)) & 1u)
+
+// 每行最后一个字中有效像素的掩码 (188 = 5*32 + 28)
+#define BIN_LAST_WORD_MASK ((IMAGE_W & 31) ? ((1u << (IMAGE_W & 31)) - 1u) : 0xFFFFFFFFu)
+
+//-------------------------------------------------------------------------------------------------------------------
+// 行流水线
+// 原流程要等整帧 DMA 完成、拷贝到 mt9v03x_image_copy 之后才开始处理，采集时间和处理时间串行相加。
+// 行流水线把只依赖单行的工作提前到采集过程中完成：
+// 1. 摄像头每送来若干行 (行中断或 DMA 半传输中断)，调用 image_stream_rows，直接读取 DMA 缓冲区中的这几行，
+//    完成直方图累加、二值化压缩 (img_row_gt_mask) 和游程编码 (与 image_processing_15.c 相同的游程表)。
+// 2. 二值化需要在行到达时就知道阈值，因此本帧使用上一帧直方图求出的大津法阈值；本帧的直方图在帧末求阈值，
+//    供下一帧使用。相邻两帧的光照变化很小，首帧使用 STREAM_DEFAULT_THRESHOLD。
+// 3. 最后一行到达后，image_stream_finish 只剩起点搜索、游程连通扫描、提纯、中线合成和拟合。
+//    最后一行到达到中线偏差 (舵机输出) 算出的周期数记录在 stream_stats.latency_cycles，
+//    曲线拟合和下一帧的大津法放在偏差输出之后，不计入延迟。
+// 4. 压缩帧、游程表和直方图双缓冲 (每组约 9.3KB)：帧末处理还没结束时下一帧的行就可能到达，
+//    行回调总是写入没有被帧末处理占用的那一组。流水线模式下不再需要 22.5KB 的整帧拷贝 mt9v03x_image_copy。
+//-------------------------------------------------------------------------------------------------------------------
+#define IMAGE_STREAM_ROWS        1   // 1: 由摄像头行回调驱动；0: image_main_process 把拷贝好的整帧一次性送入行回调
+#define STREAM_DEFAULT_THRESHOLD 128 // 首帧阈值 (还没有上一帧的直方图)
+#define STREAM_ROW_INVALID       0xFF // next_row 的特殊值：本帧丢行，等待下一帧的第0行
+#define RLE_MAX_RUNS             24  // 每行最多记录的游程数，超出的部分丢弃并计数
+#define OTSU_PIXEL_COUNT ((uint32_t)IMAGE_W * IMAGE_H)
+
+#ifndef IMAGE_CYCLE_COUNTER
+#define IMAGE_CYCLE_COUNTER() 0u // 可映射到 DWT->CYCCNT 以统计耗时
+#endif
+
+// 帧末处理认领缓冲区时屏蔽行中断。Cortex-M 上保存 PRIMASK 后关中断、退出时恢复，在已关中断的代码中调用也安全；
+// 主机端没有中断，为空操作。其它平台可在包含本文件前自行定义这两个宏。
+#ifndef IMAGE_CRITICAL_ENTER
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+#include "cmsis_compiler.h" // __get_PRIMASK / __set_PRIMASK / __disable_irq
+#define IMAGE_CRITICAL_ENTER() uint32_t image_primask = __get_PRIMASK(); __disable_irq()
+#define IMAGE_CRITICAL_EXIT()  __set_PRIMASK(image_primask)
+#else
+#define IMAGE_CRITICAL_ENTER() ((void)0)
+#define IMAGE_CRITICAL_EXIT()  ((void)0)
+#endif
+#endif
+
+typedef struct {
+    uint8_t start; // 游程第一个白像素的 x
+    uint8_t end;   // 游程最后一个白像素的 x
+} WhiteRun;
+
+typedef struct {
+    WhiteRun run[IMAGE_H][RLE_MAX_RUNS]; // 每行的白色游程，按 x 递增
+    uint8_t  count[IMAGE_H];             // 每行的游程数
+    uint16_t dropped_runs;               // 因超出 RLE_MAX_RUNS 被丢弃的游程数
+} RunFrame;
+
+// 一帧的行流水线结果
+typedef struct {
+    BinaryFrame bin;            // 压缩二值图，bin.threshold 为本帧使用的阈值
+    RunFrame    runs;           // 游程表
+    uint16_t    hist[256];      // 本帧直方图 (120*188 = 22560 个像素，uint16_t 足够)
+    uint32_t    sum;            // 本帧灰度总和
+    uint32_t    last_row_time;  // 最后一批行到达的时刻 (周期)
+} StreamBuffer;
+
+typedef struct {
+    StreamBuffer    buffer[2];
+    uint8_t         threshold;    // 下一帧使用的阈值
+    uint8_t         next_row;     // 期望到达的下一行
+    uint8_t         write_index;  // 行回调正在写入的缓冲区
+    volatile int8_t ready_index;  // 已收齐、等待帧末处理的缓冲区，-1 表示没有
+    volatile int8_t busy_index;   // 帧末处理正在读取的缓冲区，-1 表示没有
+} RowStream;
+
+typedef struct {
+    uint32_t row_cycles;      // 本帧所有行回调的耗时之和 (周期)
+    uint32_t row_cycles_max;  // 单次行回调的最大耗时 (周期)，决定行中断的最坏占用
+    uint32_t latency_cycles;  // 最后一行到达 → 中线偏差输出 (周期)
+    uint32_t finish_cycles;   // 帧末处理的总耗时，含拟合和大津法 (周期)
+    uint16_t dropped_frames;  // 收齐后没来得及处理就被覆盖的帧数
+    uint16_t row_errors;      // 行号不连续 (丢行) 的次数，该帧整帧丢弃
+} StreamStats;
+
+static RowStream   row_stream = {.threshold = STREAM_DEFAULT_THRESHOLD, .next_row = STREAM_ROW_INVALID,
+                                 .ready_index = -1, .busy_index = -1};
+static StreamStats stream_stats; // 行流水线统计
+
+static inline uint8_t ctz32(uint32_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint8_t)__builtin_ctz(v);
+#else
+    uint8_t n = 0;
+    while (!(v & 1)) { v >>= 1; n++; }
+    return n;
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      把压缩二值图的一行转换为白色游程列表
+// 备注信息      与 image_processing_15.c 的同名函数相同，这里在行到达时逐行调用。
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t packed_row_to_runs(const uint32_t *row, WhiteRun *runs, uint16_t *dropped)
+{
+    uint8_t n = 0;
+    uint8_t start = 0;
+    bool open = false;
+    uint32_t carry = 0; // 上一个字的最高位
+
+    for (int i = 0; i < BIN_ROW_WORDS; i++)
+    {
+        uint32_t w = row[i];
+        uint32_t next = (i + 1 < BIN_ROW_WORDS) ? (row[i + 1] & 1u) : 0;
+        uint32_t starts = w & ~((w << 1) | carry);
+        uint32_t ends   = w & ~((w >> 1) | (next << 31));
+        uint8_t base = (uint8_t)(i * 32);
+        carry = w >> 31;
+
+        while (starts | ends)
+        {
+            if (!open)
+            {
+                start = base + ctz32(starts);
+                starts &= starts - 1;
+                open = true;
+            }
+            else
+            {
+                uint8_t end = base + ctz32(ends);
+                ends &= ends - 1;
+                open = false;
+                if (n < RLE_MAX_RUNS)
+                {
+                    runs[n].start = start;
+                    runs[n].end = end;
+                    n++;
+                }
+                else
+                {
+                    (*dropped)++;
+                }
+            }
+        }
+    }
+    return n;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      用纯整数运算求大津法 (Otsu) 阈值
+// 备注信息      与 image_processing_06.c 的同名函数相同，直方图为整帧 uint16_t 计数。
+//-------------------------------------------------------------------------------------------------------------------
+static uint8_t otsu_threshold(const uint16_t hist[256], uint32_t total_sum)
+{
+    uint32_t w0 = 0;          // 背景像素数
+    uint32_t s0 = 0;          // 背景灰度和
+    uint64_t best_score = 0;
+    uint8_t  best_t = 128;    // 直方图退化（单一灰度）时保持默认阈值
+
+    for (int t = 0; t < 255; t++)
+    {
+        w0 += hist[t];
+        s0 += (uint32_t)t * hist[t];
+        if (w0 == 0)
+        {
+            continue;
+        }
+        uint32_t w1 = OTSU_PIXEL_COUNT - w0;
+        if (w1 == 0)
+        {
+            break;
+        }
+
+        int64_t d = ((int64_t)total_sum * w0 - (int64_t)s0 * OTSU_PIXEL_COUNT) / (int64_t)OTSU_PIXEL_COUNT;
+        uint64_t score = ((uint64_t)(d * d) << 16) / ((uint64_t)w0 * w1);
+        if (score > best_score)
+        {
+            best_score = score;
+            best_t = (uint8_t)t;
+        }
+    }
+    return best_t;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      新的一帧开始：选择写入缓冲区并锁定本帧阈值
+// 备注信息      两组缓冲区轮流写入，但不能写帧末处理正在读取的那一组；若选中的一组收齐后还没被处理，
+//               说明帧末处理跟不上帧率，该帧被新帧覆盖并计入 dropped_frames。
+//-------------------------------------------------------------------------------------------------------------------
+static void stream_begin_frame(RowStream *stream)
+{
+    uint8_t index = stream->write_index ^ 1;
+    if (index == stream->busy_index)
+    {
+        index ^= 1;
+    }
+    if (index == stream->ready_index)
+    {
+        stream->ready_index = -1;
+        stream_stats.dropped_frames++;
+    }
+    stream->write_index = index;
+
+    StreamBuffer *buffer = &stream->buffer[index];
+    buffer->bin.threshold = stream->threshold;
+    buffer->runs.dropped_runs = 0;
+    buffer->sum = 0;
+    memset(buffer->hist, 0, sizeof(buffer->hist));
+    stream_stats.row_cycles = 0;
+    stream_stats.row_cycles_max = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      行回调：处理摄像头刚送来的若干行
+// 参数说明      stream        行流水线状态
+// 参数说明      rows          第 y0 行的行首地址，n 行连续存放 (可直接指向 DMA 缓冲区)
+// 参数说明      y0            第一行的行号
+// 参数说明      n             行数，y0 + n 不超过 IMAGE_H
+// 备注信息      在行中断或 DMA 半传输中断中调用，行必须按顺序送入；y0 为0时开始新的一帧。
+//               每行读取一次灰度数据，同时得到直方图、压缩行和游程，之后不再访问灰度图。
+//               收到第 IMAGE_H - 1 行后把缓冲区交给 image_stream_finish。
+//-------------------------------------------------------------------------------------------------------------------
+void image_stream_rows(RowStream *stream, const uint8_t *rows, uint8_t y0, uint8_t n)
+{
+    const uint32_t t0 = IMAGE_CYCLE_COUNTER();
+
+    if (y0 == 0)
+    {
+        stream_begin_frame(stream);
+        stream->next_row = 0;
+    }
+    if (y0 != stream->next_row || y0 + n > IMAGE_H)
+    {
+        // 丢行或行号错乱：整帧作废，等下一帧的第0行
+        if (stream->next_row != STREAM_ROW_INVALID)
+        {
+            stream_stats.row_errors++;
+            stream->next_row = STREAM_ROW_INVALID;
+        }
+        return;
+    }
+
+    StreamBuffer *buffer = &stream->buffer[stream->write_index];
+    for (uint8_t i = 0; i < n; i++)
+    {
+        const uint8_t y = y0 + i;
+        const uint8_t *row = rows + i * IMAGE_W;
+
+        buffer->sum += img_row_histogram(row, IMAGE_W, buffer->hist);
+        img_row_gt_mask(row, IMAGE_W, buffer->bin.threshold, buffer->bin.row[y]);
+        buffer->runs.count[y] = packed_row_to_runs(buffer->bin.row[y], buffer->runs.run[y], &buffer->runs.dropped_runs);
+    }
+    stream->next_row = y0 + n;
+
+    if (stream->next_row == IMAGE_H)
+    {
+        buffer->last_row_time = t0; // 最后一批行到达的时刻，本次回调的处理也计入延迟
+        if (stream->ready_index >= 0)
+        {
+            stream_stats.dropped_frames++; // 上一帧收齐后还没被处理，由这一帧取代
+        }
+        stream->ready_index = (int8_t)stream->write_index;
+        stream->next_row = STREAM_ROW_INVALID;
+    }
+
+    const uint32_t cycles = IMAGE_CYCLE_COUNTER() - t0;
+    stream_stats.row_cycles += cycles;
+    if (cycles > stream_stats.row_cycles_max)
+    {
+        stream_stats.row_cycles_max = cycles;
+    }
+}
+
+void fit_edges_with_bezier(TrackContext *context); // 实现见 image_processing_04.c
+bool get_start_point_packed(const BinaryFrame *frame, point *p_left, point *p_right); // 实现见 image_processing_05.c
+void extract_and_filter_edges_fused(TrackContext *context); // 实现见 image_processing_11.c
+bool build_row_maps_from_runs(const RunFrame *runs, TrackContext *context); // 实现见 image_processing_15.c
+void build_midline(TrackContext *context); // 实现见 image_processing_21.c
+void midline_init(void); // 实现见 image_processing_21.c
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      帧末处理：对已收齐的一帧完成循迹、中线和拟合
+// 参数说明      stream        行流水线状态
+// 参数说明      context       指向TrackContext的指针
+// 返回参数      bool          有收齐的帧并找到赛道返回true；没有新帧或找不到起点返回false
+// 备注信息      在主循环中调用。起点搜索和连通扫描都从底行开始，必须等最后一行到达；
+//               其余逐行工作已经在行回调中完成，这里只读取压缩帧和游程表。
+//-------------------------------------------------------------------------------------------------------------------
+bool image_stream_finish(RowStream *stream, TrackContext *context)
+{
+    // 读取 ready_index 和写入 busy_index 之间若进入行回调并开始新的一帧，stream_begin_frame 看不到占用，
+    // 可能选中这一组并覆盖它；关中断的区间只有这几条读写
+    IMAGE_CRITICAL_ENTER();
+    const int8_t index = stream->ready_index;
+    if (index >= 0)
+    {
+        stream->busy_index = index;
+        stream->ready_index = -1;
+    }
+    IMAGE_CRITICAL_EXIT();
+    if (index < 0)
+    {
+        return false;
+    }
+
+    StreamBuffer *buffer = &stream->buffer[index];
+    context->left_edge.threshold = buffer->bin.threshold;
+    context->right_edge.threshold = buffer->bin.threshold;
+    midline_init(); // 仅第一次调用时生成宽度表和权重表
+
+    // --- 1. 起点搜索 + 游程连通扫描 + 提纯 + 中线 ---
+    bool found = get_start_point_packed(&buffer->bin, &context->left_edge.start_point, &context->right_edge.start_point) &&
+                 build_row_maps_from_runs(&buffer->runs, context);
+    if (found)
+    {
+        extract_and_filter_edges_fused(context);
+        build_midline(context);
+    }
+    else
+    {
+        context->mid_line.is_found = false; // 偏差保持上一帧的值
+    }
+    stream_stats.latency_cycles = IMAGE_CYCLE_COUNTER() - buffer->last_row_time;
+
+    // --- 2. 不影响本帧输出的工作 ---
+    if (found)
+    {
+        fit_edges_with_bezier(context);
+    }
+    stream->threshold = otsu_threshold(buffer->hist, buffer->sum);
+
+    stream->busy_index = -1;
+    stream_stats.finish_cycles = IMAGE_CYCLE_COUNTER() - buffer->last_row_time;
+    return found;
+}
+
+//-------------------------------------------------------------------------------------------------------------------
+// 函数简介      图像处理主流程（行流水线版本）
+// 参数说明      context       指向TrackContext的指针，用于管理整个处理过程的数据
+// 备注信息      IMAGE_STREAM_ROWS 为1时，逐行工作已由摄像头驱动的行回调完成：
+//                   image_stream_rows(&row_stream, &mt9v03x_image[y0][0], y0, n);
+//               这里只做帧末处理，没有收齐的新帧时直接返回。
+//               IMAGE_STREAM_ROWS 为0时，把拷贝好的整帧一次性送入行回调，结果与流水线模式相同，便于对比和调试。
+//-------------------------------------------------------------------------------------------------------------------
+void image_main_process(TrackContext *context) {
+
+#if !IMAGE_STREAM_ROWS
+    // --- 0. 整帧模式：一次送入全部行 ---
+    image_stream_rows(&row_stream, mt9v03x_image_copy[0], 0, IMAGE_H);
+#endif
+
+    // --- 1. 帧末处理 ---
+    image_stream_finish(&row_stream, context);
+}
\ No newline at end of file